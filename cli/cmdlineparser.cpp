@@ -115,6 +115,18 @@ bool CmdLineParser::ParseFromArgs(int argc, const char* const argv[])
     bool def = false;
     bool maxconfigs = false;
 
+    // The library cache must be known before any --library option is handled
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--library-cache=", 16) == 0) {
+            const std::string cachedir(Path::fromNativeSeparators(argv[i]+16));
+            if (!FileLister::isDirectory(cachedir)) {
+                PrintMessage("seccheck: directory '" + cachedir + "' given in '--library-cache=' does not exist.");
+                return false;
+            }
+            _settings->library.setcachedir(cachedir);
+        }
+    }
+
     for (int i = 1; i < argc; i++) {
         if (std::strcmp(argv[i], "--version") == 0) {
             _showVersion = true;
@@ -554,6 +566,10 @@ bool CmdLineParser::ParseFromArgs(int argc, const char* const argv[])
             }
         }
 
+        // --library-cache is handled before the other options
+        else if (std::strncmp(argv[i], "--library-cache=", 16) == 0) {
+        }
+
         // Report progress
         else if (std::strcmp(argv[i], "--report-progress") == 0) {
             _settings->reportProgress = true;
@@ -784,6 +800,47 @@ bool CmdLineParser::ParseFromArgs(int argc, const char* const argv[])
             maxconfigs = true;
         }
 
+        // Max number of template instantiations per translation unit
+        else if (std::strncmp(argv[i], "--max-template-instantiations=", 30) == 0) {
+            std::istringstream iss(30+argv[i]);
+            if (!(iss >> _settings->maxTemplateInstantiations)) {
+                PrintMessage("seccheck: argument to '--max-template-instantiations=' is not a number.");
+                return false;
+            }
+        }
+
+        // Max number of values per token in the value flow analysis
+        else if (std::strncmp(argv[i], "--valueflow-max-values=", 23) == 0) {
+            std::istringstream iss(23+argv[i]);
+            if (!(iss >> _settings->valueFlowMaxValues)) {
+                PrintMessage("seccheck: argument to '--valueflow-max-values=' is not a number.");
+                return false;
+            }
+        }
+
+        // Max number of value flow steps per function
+        else if (std::strncmp(argv[i], "--valueflow-max-steps=", 22) == 0) {
+            std::istringstream iss(22+argv[i]);
+            if (!(iss >> _settings->valueFlowMaxSteps)) {
+                PrintMessage("seccheck: argument to '--valueflow-max-steps=' is not a number.");
+                return false;
+            }
+        }
+
+        // Threads that run the checks of one translation unit
+        else if (std::strncmp(argv[i], "--check-threads=", 16) == 0) {
+            std::istringstream iss(16+argv[i]);
+            if (!(iss >> _settings->checkThreads)) {
+                PrintMessage("seccheck: argument to '--check-threads=' is not a number.");
+                return false;
+            }
+
+            if (_settings->checkThreads < 1 || _settings->checkThreads > 256) {
+                PrintMessage("seccheck: argument to '--check-threads=' must be between 1 and 256.");
+                return false;
+            }
+        }
+
         // Print help
         else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
             _pathnames.clear();
@@ -860,6 +917,11 @@ void CmdLineParser::PrintHelp()
               "                         analysis is disabled by this flag.\n"
               "    --check-library      Show information messages when library files have\n"
               "                         incomplete info.\n"
+              "    --check-threads=<n>  Run the checks of a translation unit in <n> threads.\n"
+              "                         Checks that only read the token list run concurrently,\n"
+              "                         the output is the same as with serial checking.\n"
+              "                         Default is '1'. Ignored when --showtime or\n"
+              "                         --check-library is used.\n"
               "    --dump               Dump xml data for each translation unit. The dump\n"
               "                         files have the extension .dump and contain ast,\n"
               "                         tokenlist, symboldatabase, valueflow.\n"
@@ -956,11 +1018,20 @@ void CmdLineParser::PrintHelp()
               "                         language. Valid values are: c, c++\n"
               "    --library=<cfg>\n"
               "                         Use library configuration.\n"
+              "    --library-cache=<dir>\n"
+              "                         Keep compiled library configurations in <dir>. The\n"
+              "                         .cfg files are then only parsed when they have\n"
+              "                         changed, or the first time a combination of them\n"
+              "                         is used.\n"
               "    --max-configs=<limit>\n"
               "                         Maximum number of configurations to check in a file\n"
               "                         before skipping it. Default is '12'. If used together\n"
               "                         with '--force', the last option is the one that is\n"
               "                         effective.\n"
+              "    --max-template-instantiations=<limit>\n"
+              "                         Maximum number of template instantiations in a\n"
+              "                         translation unit. Templates are not expanded further\n"
+              "                         when the limit is reached. Default is '0' (no limit).\n"
               "    --platform=<type>    Specifies platform specific types and sizes. The\n"
               "                         available platforms are:\n"
               "                          * unix32\n"
@@ -1018,6 +1089,13 @@ void CmdLineParser::PrintHelp()
               "                         '{file}({line}):({severity}) {message}' or\n"
               "                         '{callstack} {message}'\n"
               "                         Pre-defined templates: gcc, vs, edit.\n"
+              "    --valueflow-max-steps=<limit>\n"
+              "                         Maximum number of value flow steps in a function. The\n"
+              "                         value flow analysis of the function bails out when the\n"
+              "                         limit is reached. Default is '0' (no limit).\n"
+              "    --valueflow-max-values=<limit>\n"
+              "                         Maximum number of value flow values for a token.\n"
+              "                         Default is '0' (no limit).\n"
               "    -v, --verbose        Output more detailed error information.\n"
               "    --version            Print out version number.\n"
               "    --xml                Write results in xml format to error stream (stderr).\n"
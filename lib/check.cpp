@@ -21,8 +21,16 @@
 //---------------------------------------------------------------------------
 
 #include "check.h"
+#include "symboldatabase.h"
+#include "timer.h"
 
+#include <atomic>
+#include <exception>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <system_error>
+#include <thread>
 
 //---------------------------------------------------------------------------
 
@@ -38,6 +46,26 @@ Check::Check(const std::string &aname)
     instances().push_back(this);
 }
 
+bool Check::isNeeded(Phase phase, const Settings *settings) const
+{
+    if ((phases() & phase) == 0)
+        return false;
+
+    const unsigned int sev = severities();
+    if (sev == 0 || (sev & (severityBit(Severity::error) | severityBit(Severity::debug))))
+        return true;
+
+    static const Severity::SeverityType enabledBySettings[] = {
+        Severity::warning, Severity::style, Severity::performance, Severity::portability, Severity::information
+    };
+    for (std::size_t i = 0; i < sizeof(enabledBySettings) / sizeof(*enabledBySettings); ++i) {
+        const Severity::SeverityType severity = enabledBySettings[i];
+        if ((sev & severityBit(severity)) && settings->isEnabled(Severity::toString(severity)))
+            return true;
+    }
+    return false;
+}
+
 void Check::reportError(const ErrorLogger::ErrorMessage &errmsg)
 {
     std::cout << errmsg.toXML(true, 1) << std::endl;
@@ -55,3 +83,246 @@ std::list<Check *> &Check::instances()
     return _instances;
 #endif
 }
+
+//---------------------------------------------------------------------------
+
+TokenDispatcher::TokenDispatcher(unsigned int showtimeMode, TimerResultsIntf *timerResults)
+    : _showtimeMode(showtimeMode), _timerResults(timerResults)
+{
+}
+
+TokenDispatcher::~TokenDispatcher()
+{
+    for (std::list<Handler *>::const_iterator it = _handlers.begin(); it != _handlers.end(); ++it)
+        delete *it;
+    for (std::list<Check *>::const_iterator it = _checks.begin(); it != _checks.end(); ++it)
+        delete *it;
+}
+
+void TokenDispatcher::handleToken(const std::vector<Handler *> &handlers, const Token *tok, bool inFunctionBody)
+{
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+        Handler * const handler = handlers[i];
+        if (handler->where == FUNCTION_BODIES && !inFunctionBody)
+            continue;
+        if (_showtimeMode == SHOWTIME_NONE) {
+            handler->handleToken(tok);
+        } else {
+            const std::clock_t start = std::clock();
+            handler->handleToken(tok);
+            handler->clocks += std::clock() - start;
+        }
+    }
+}
+
+void TokenDispatcher::run(const Tokenizer *tokenizer)
+{
+    if (_handlers.empty())
+        return;
+
+    const Token *functionBodyEnd = nullptr;
+    for (const Token *tok = tokenizer->tokens(); tok; tok = tok->next()) {
+        if (tok == functionBodyEnd)
+            functionBodyEnd = nullptr;
+        else if (!functionBodyEnd && tok->str() == "{" && tok->scope() && tok->scope()->type == Scope::eFunction && tok->scope()->classStart == tok)
+            functionBodyEnd = tok->scope()->classEnd;
+
+        if ((std::size_t)tok->type() < _byType.size())
+            handleToken(_byType[tok->type()], tok, functionBodyEnd != nullptr);
+        if (!_byStr.empty()) {
+            const std::unordered_map<std::string, std::vector<Handler *> >::const_iterator it = _byStr.find(tok->str());
+            if (it != _byStr.end())
+                handleToken(it->second, tok, functionBodyEnd != nullptr);
+        }
+    }
+
+    if (_showtimeMode == SHOWTIME_NONE)
+        return;
+
+    // a handler that is subscribed to several tokens is reported once
+    std::map<std::string, std::clock_t> clocks;
+    for (std::list<Handler *>::const_iterator it = _handlers.begin(); it != _handlers.end(); ++it)
+        clocks[(*it)->name] += (*it)->clocks;
+    for (std::map<std::string, std::clock_t>::const_iterator it = clocks.begin(); it != clocks.end(); ++it) {
+        if (_showtimeMode == SHOWTIME_FILE)
+            std::cout << it->first << ": " << (double)it->second / CLOCKS_PER_SEC << "s" << std::endl;
+        else if (_timerResults)
+            _timerResults->AddResults(it->first, it->second);
+    }
+}
+
+//---------------------------------------------------------------------------
+
+namespace {
+    /** Helper threads of all parallel loops */
+    std::atomic<unsigned int> helperThreads(0);
+
+    /** Reserve a helper thread if there are less than maxThreads threads */
+    bool reserveHelperThread(unsigned int maxThreads)
+    {
+        unsigned int helpers = helperThreads.load();
+        while (helpers + 1U < maxThreads) {
+            if (helperThreads.compare_exchange_weak(helpers, helpers + 1U))
+                return true;
+        }
+        return false;
+    }
+
+    /** A message that is passed on when the loop is done */
+    struct Message {
+        enum Kind { OUT, ERR, INFO };
+        explicit Message(Kind k) : kind(k) {
+        }
+        Kind kind;
+        std::string outmsg;
+        ErrorLogger::ErrorMessage errmsg;
+    };
+}
+
+class ParallelLoop::Loop {
+public:
+    explicit Loop(std::size_t n) : messages(n), exceptions(n), next(0) {
+    }
+
+    /** buffered messages of each index */
+    std::vector<std::vector<Message> > messages;
+    std::vector<std::exception_ptr> exceptions;
+    std::atomic<std::size_t> next;
+
+    /** index that each thread of the loop works on */
+    std::map<std::thread::id, std::size_t> current;
+    std::mutex mutex;
+
+    /** Buffer of the calling thread, nullptr if it is not a thread of the loop */
+    std::vector<Message> *buffer() {
+        const std::map<std::thread::id, std::size_t>::const_iterator it = current.find(std::this_thread::get_id());
+        return (it == current.end()) ? nullptr : &messages[it->second];
+    }
+};
+
+ParallelLoop::ParallelLoop(ErrorLogger *errorLogger, const Settings *settings)
+    : _errorLogger(errorLogger), _threads(threads(settings)), _loop(nullptr)
+{
+}
+
+unsigned int ParallelLoop::threads(const Settings *settings)
+{
+    // The time of a check can't be measured while other parts run. The
+    // debug warnings of the tokenizer and symbol database bypass the loop,
+    // and so do the --debug token list dumps that checks write to stdout and
+    // the --check-library messages of Tokenizer::IsScopeNoReturn().
+    if (!settings || settings->_showtime != SHOWTIME_NONE || settings->debugwarnings || settings->debug || settings->checkLibrary)
+        return 1U;
+    return settings->checkThreads;
+}
+
+void ParallelLoop::forEach(std::size_t n, Body &body)
+{
+    if (_threads <= 1U || n <= 1U || _loop) {
+        for (std::size_t i = 0; i < n; ++i)
+            body.run(i);
+        return;
+    }
+
+    Loop loop(n);
+    _loop = &loop;
+
+    auto runIndex = [&](std::size_t i) {
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            loop.current[std::this_thread::get_id()] = i;
+        }
+        try {
+            body.run(i);
+        } catch (...) {
+            loop.exceptions[i] = std::current_exception();
+        }
+    };
+    auto helper = [&]() {
+        for (std::size_t i = loop.next++; i < n; i = loop.next++)
+            runIndex(i);
+        --helperThreads;
+    };
+
+    // The calling thread takes part and starts helper threads while there
+    // is work left for them
+    std::vector<std::thread> threads;
+    for (std::size_t i = loop.next++; i < n; i = loop.next++) {
+        if (threads.size() + 1U < _threads && i + 1U < n && reserveHelperThread(_threads)) {
+            try {
+                threads.push_back(std::thread(helper));
+            } catch (const std::system_error &) {
+                --helperThreads;
+            }
+        }
+        runIndex(i);
+    }
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    _loop = nullptr;
+
+    // Same output as a serial loop: nothing is reported after the index
+    // that threw an exception
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < loop.messages[i].size(); ++j) {
+            const Message &message = loop.messages[i][j];
+            if (message.kind == Message::OUT)
+                reportOut(message.outmsg);
+            else if (message.kind == Message::ERR)
+                reportErr(message.errmsg);
+            else
+                reportInfo(message.errmsg);
+        }
+        if (loop.exceptions[i])
+            std::rethrow_exception(loop.exceptions[i]);
+    }
+}
+
+void ParallelLoop::reportOut(const std::string &outmsg)
+{
+    if (_loop) {
+        std::lock_guard<std::mutex> lock(_loop->mutex);
+        std::vector<Message> *buffer = _loop->buffer();
+        if (buffer) {
+            buffer->push_back(Message(Message::OUT));
+            buffer->back().outmsg = outmsg;
+            return;
+        }
+    }
+    _errorLogger->reportOut(outmsg);
+}
+
+void ParallelLoop::reportErr(const ErrorLogger::ErrorMessage &msg)
+{
+    if (_loop) {
+        std::lock_guard<std::mutex> lock(_loop->mutex);
+        std::vector<Message> *buffer = _loop->buffer();
+        if (buffer) {
+            buffer->push_back(Message(Message::ERR));
+            buffer->back().errmsg = msg;
+            return;
+        }
+    }
+    _errorLogger->reportErr(msg);
+}
+
+void ParallelLoop::reportInfo(const ErrorLogger::ErrorMessage &msg)
+{
+    if (_loop) {
+        std::lock_guard<std::mutex> lock(_loop->mutex);
+        std::vector<Message> *buffer = _loop->buffer();
+        if (buffer) {
+            buffer->push_back(Message(Message::INFO));
+            buffer->back().errmsg = msg;
+            return;
+        }
+    }
+    _errorLogger->reportInfo(msg);
+}
+
+void ParallelLoop::reportProgress(const std::string &filename, const char stage[], const std::size_t value)
+{
+    // progress is not buffered, it is only passed on by the calling thread
+    if (!_loop)
+        _errorLogger->reportProgress(filename, stage, value);
+}
@@ -29,6 +29,12 @@
 
 #include <list>
 #include <set>
+#include <unordered_map>
+#include <vector>
+#include <ctime>
+
+class TimerResultsIntf;
+class TokenDispatcher;
 
 /// @addtogroup Core
 /// @{
@@ -65,6 +71,63 @@ public:
     /** get error messages */
     virtual void getErrorMessages(ErrorLogger *errorLogger, const Settings *settings) const = 0;
 
+    /** Token lists that a check works on */
+    enum Phase {
+        NORMAL = 1,     ///< runChecks() is used
+        SIMPLIFIED = 2  ///< runSimplifiedChecks() is used
+    };
+
+    /**
+     * Subscribe token handlers to the single pass over the token list of a
+     * phase, see TokenDispatcher. The handlers run before runChecks() or
+     * runSimplifiedChecks(). A check is migrated by moving a token loop
+     * from runChecks() into a handler that is subscribed here.
+     */
+    virtual void subscribe(TokenDispatcher &dispatcher, Phase phase, const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+        (void)dispatcher;
+        (void)phase;
+        (void)tokenizer;
+        (void)settings;
+        (void)errorLogger;
+    }
+
+    /** Phases that the check needs, a combination of Phase values */
+    virtual unsigned int phases() const {
+        return NORMAL | SIMPLIFIED;
+    }
+
+    /**
+     * Can the check run concurrently with other checks (--check-threads)?
+     * A check that modifies the token list, the symbol database or other
+     * shared state must return false, it is then run serially.
+     */
+    virtual bool isThreadSafe() const {
+        return true;
+    }
+
+    /** Bit for a severity in the value returned by severities() */
+    static unsigned int severityBit(Severity::SeverityType severity) {
+        return 1U << severity;
+    }
+
+    /**
+     * Severities of all messages that the check can report, a combination
+     * of severityBit() values. 0 means "unknown" and such a check is always run.
+     * Only checks that don't report anything unless the severity is enabled
+     * in the settings should declare their severities.
+     */
+    virtual unsigned int severities() const {
+        return 0;
+    }
+
+    /**
+     * Is the check needed for the given phase and settings?
+     * @param phase NORMAL or SIMPLIFIED
+     * @param settings settings
+     * @return false if the check can't report anything in this phase
+     */
+    bool isNeeded(Phase phase, const Settings *settings) const;
+
     /** class name, used to generate documentation */
     const std::string& name() const {
         return _name;
@@ -136,6 +199,172 @@ private:
     Check(const Check &);
 };
 
+
+/**
+ * @brief Single pass over the token list for the token handlers of all checks.
+ *
+ * Checks subscribe handlers (member functions that take a token) to token
+ * strings such as keywords, operators and function names, or to token types
+ * such as comparison or assignment operators. run() walks the token list
+ * once. For each token it calls the handlers subscribed to the token type
+ * first and then the handlers subscribed to the token string, each in the
+ * order they were subscribed. The time spent in each handler is reported
+ * with --showtime.
+ */
+class CPPCHECKLIB TokenDispatcher {
+public:
+    /** Tokens that a handler is called for */
+    enum Where {
+        ALL_TOKENS,     ///< the whole token list
+        FUNCTION_BODIES ///< tokens in the function bodies
+    };
+
+    TokenDispatcher(unsigned int showtimeMode = 0, TimerResultsIntf *timerResults = nullptr);
+    ~TokenDispatcher();
+
+    /** Add a check instance for the handlers, it is deleted with the dispatcher */
+    template<class T>
+    T *addCheck(T *check) {
+        _checks.push_back(check);
+        return check;
+    }
+
+    /** Call check->*handler for the tokens with the given str */
+    template<class T>
+    void subscribe(const std::string &str, T *check, void (T::*handler)(const Token *), const char name[], Where where = ALL_TOKENS) {
+        _byStr[str].push_back(addHandler(new MemberHandler<T>(check, handler, name, where)));
+    }
+
+    /** Call check->*handler for the tokens of the given type */
+    template<class T>
+    void subscribe(Token::Type type, T *check, void (T::*handler)(const Token *), const char name[], Where where = ALL_TOKENS) {
+        if (_byType.size() <= (std::size_t)type)
+            _byType.resize(type + 1U);
+        _byType[type].push_back(addHandler(new MemberHandler<T>(check, handler, name, where)));
+    }
+
+    /** Walk the token list once and call the subscribed handlers */
+    void run(const Tokenizer *tokenizer);
+
+private:
+    class Handler {
+    public:
+        Handler(const std::string &aname, Where awhere) : name(aname), where(awhere), clocks(0) {
+        }
+        virtual ~Handler() {
+        }
+        virtual void handleToken(const Token *tok) = 0;
+
+        /** name for --showtime: "check name::handler name" */
+        const std::string name;
+        const Where where;
+        std::clock_t clocks;
+    };
+
+    template<class T>
+    class MemberHandler : public Handler {
+    public:
+        MemberHandler(T *check, void (T::*handler)(const Token *), const char aname[], Where awhere)
+            : Handler(check->name() + "::" + aname, awhere), _check(check), _handler(handler) {
+        }
+        void handleToken(const Token *tok) {
+            (_check->*_handler)(tok);
+        }
+    private:
+        T * const _check;
+        void (T::* const _handler)(const Token *);
+    };
+
+    Handler *addHandler(Handler *handler) {
+        _handlers.push_back(handler);
+        return handler;
+    }
+
+    void handleToken(const std::vector<Handler *> &handlers, const Token *tok, bool inFunctionBody);
+
+    const unsigned int _showtimeMode;
+    TimerResultsIntf * const _timerResults;
+    std::list<Check *> _checks;
+    std::list<Handler *> _handlers;
+    std::vector<std::vector<Handler *> > _byType;
+    std::unordered_map<std::string, std::vector<Handler *> > _byStr;
+
+    /** disabled assignment operator and copy constructor */
+    void operator=(const TokenDispatcher &);
+    TokenDispatcher(const TokenDispatcher &);
+};
+
+
+/**
+ * @brief Loop over independent parts of a check that runs in parallel with
+ * --check-threads.
+ *
+ * A check that analyses function scopes or variables independently of each
+ * other creates an instance that reports to a ParallelLoop and calls
+ * forEach() on it. The messages of each index are buffered and passed on in
+ * index order when the loop is done, so the output is the same as with a
+ * serial loop. Outside of forEach() the messages are passed on directly.
+ *
+ * All loops share a budget of --check-threads threads. A loop that is
+ * started by a thread of another loop gets helper threads when the other
+ * threads are done.
+ */
+class CPPCHECKLIB ParallelLoop : public ErrorLogger {
+public:
+    /** The body of a loop */
+    class Body {
+    public:
+        virtual ~Body() {
+        }
+        virtual void run(std::size_t i) = 0;
+    };
+
+    ParallelLoop(ErrorLogger *errorLogger, const Settings *settings);
+
+    /** Number of threads of the loops, 1 if they are run serially */
+    static unsigned int threads(const Settings *settings);
+
+    /** Call body.run(i) for i = 0..n-1 */
+    void forEach(std::size_t n, Body &body);
+
+    /** Call (check->*analyse)(i) for i = 0..n-1 */
+    template<class T>
+    void forEach(std::size_t n, T *check, void (T::*analyse)(std::size_t)) {
+        MemberBody<T> body(check, analyse);
+        forEach(n, body);
+    }
+
+    void reportOut(const std::string &outmsg);
+    void reportErr(const ErrorLogger::ErrorMessage &msg);
+    void reportInfo(const ErrorLogger::ErrorMessage &msg);
+    void reportProgress(const std::string &filename, const char stage[], const std::size_t value);
+
+private:
+    template<class T>
+    class MemberBody : public Body {
+    public:
+        MemberBody(T *check, void (T::*analyse)(std::size_t)) : _check(check), _analyse(analyse) {
+        }
+        void run(std::size_t i) {
+            (_check->*_analyse)(i);
+        }
+    private:
+        T * const _check;
+        void (T::* const _analyse)(std::size_t);
+    };
+
+    /** State of a running loop, see check.cpp */
+    class Loop;
+
+    ErrorLogger * const _errorLogger;
+    const unsigned int _threads;
+    Loop *_loop;
+
+    /** disabled assignment operator and copy constructor */
+    void operator=(const ParallelLoop &);
+    ParallelLoop(const ParallelLoop &);
+};
+
 /// @}
 //---------------------------------------------------------------------------
 #endif //  checkH
@@ -57,6 +57,14 @@ public:
         (void)errorLogger;
     }
 
+    unsigned int phases() const {
+        return NORMAL;
+    }
+
+    unsigned int severities() const {
+        return severityBit(Severity::portability);
+    }
+
     /** Check for pointer assignment */
     void pointerassignment();
 
@@ -46,6 +46,14 @@ public:
         check.assertWithSideEffects();
     }
 
+    unsigned int phases() const {
+        return SIMPLIFIED;
+    }
+
+    unsigned int severities() const {
+        return severityBit(Severity::warning);
+    }
+
     void assertWithSideEffects();
 
 protected:
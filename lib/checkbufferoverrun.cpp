@@ -841,7 +841,15 @@ void CheckBufferOverrun::valueFlowCheckArrayIndex(const Token * const tok, const
 
 
 
-void CheckBufferOverrun::checkScope(const Token *tok, const ArrayInfo &arrayInfo)
+// Next token to check: the next use of the array if the uses are known, else the next token
+static const Token *nextToken(const Token *tok, const std::vector<const Token *> *uses, std::size_t &nextUse, const Token *end)
+{
+    if (!uses)
+        return tok->next();
+    return nextUse < uses->size() ? (*uses)[nextUse++] : end;
+}
+
+void CheckBufferOverrun::checkScope(const Token *tok, const ArrayInfo &arrayInfo, const std::vector<const Token *> *uses, std::size_t firstUse)
 {
     const MathLib::bigint total_size = arrayInfo.num(0) * arrayInfo.element_size();
 
@@ -855,13 +863,20 @@ void CheckBufferOverrun::checkScope(const Token *tok, const ArrayInfo &arrayInfo
 
     bool reassigned = false;
 
-    for (const Token* const end = tok->scope()->classEnd; tok != end; tok = tok->next()) {
+    // Other tokens can't produce a warning, so only the uses are visited if they are known
+    std::size_t nextUse = firstUse;
+    if (uses && nextUse < uses->size() && (*uses)[nextUse] == tok)
+        ++nextUse;
+
+    for (const Token* const end = tok->scope()->classEnd; tok != end; tok = nextToken(tok, uses, nextUse, end)) {
         if (reassigned && tok->str() == ";")
             break;
 
         if (tok->varId() == declarationId) {
             if (tok->strAt(1) == "=") {
                 reassigned = true;
+                // visit every token until the end of the statement
+                uses = nullptr;
             }
 
             else if (tok->strAt(1) == "[") {
@@ -1091,7 +1106,22 @@ void CheckBufferOverrun::checkGlobalAndLocalVariable()
             if (tok->str() == "{")
                 tok = tok->next();
             const ArrayInfo arrayInfo(var, _tokenizer, i);
-            checkScope(tok, arrayInfo);
+
+            // local array: only its uses after the declaration need to be checked
+            const Scope *functionScope = var->scope();
+            while (functionScope && functionScope->isExecutable() && functionScope->type != Scope::eFunction)
+                functionScope = functionScope->nestedIn;
+            if (functionScope && functionScope->type == Scope::eFunction && tok->scope() == var->scope()) {
+                const std::vector<const Token *> *uses = findArrayUses(functionScope, i);
+                std::size_t firstUse = 0;
+                for (const Token *tok2 = var->nameToken(); uses && tok2 != tok && firstUse < uses->size(); tok2 = tok2->next()) {
+                    if ((*uses)[firstUse] == tok2)
+                        ++firstUse;
+                }
+                checkScope(tok, arrayInfo, uses, firstUse);
+            } else {
+                checkScope(tok, arrayInfo);
+            }
         }
     }
 
@@ -1204,7 +1234,7 @@ void CheckBufferOverrun::checkStructVariable()
         const Scope * scope = symbolDatabase->classAndStructScopes[i];
 
         // check all variables to see if they are arrays
-        std::list<Variable>::const_iterator var;
+        std::deque<Variable>::const_iterator var;
         for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
             if (var->isArray()) {
                 // create ArrayInfo from the array variable
@@ -1228,7 +1258,7 @@ void CheckBufferOverrun::checkStructVariable()
                         if (func_scope->classStart->next() != func_scope->classEnd) {
                             // start checking after the {
                             const Token *tok = func_scope->classStart->next();
-                            checkScope(tok, arrayInfo);
+                            checkScope(tok, arrayInfo, tok->scope() == func_scope ? findArrayUses(func_scope, arrayInfo.declarationId()) : nullptr);
                         }
                     }
 
@@ -1365,8 +1395,47 @@ void CheckBufferOverrun::checkStructVariable()
 }
 //---------------------------------------------------------------------------
 
+void CheckBufferOverrun::createArrayUseIndex()
+{
+    arrayUses.clear();
+
+    const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
+    const std::size_t functions = symbolDatabase->functionScopes.size();
+    for (std::size_t i = 0; i < functions; ++i) {
+        const Scope * scope = symbolDatabase->functionScopes[i];
+        std::unordered_map<unsigned int, std::vector<const Token *> > &uses = arrayUses[scope];
+        for (const Token *tok = scope->classStart; tok != scope->classEnd; tok = tok->next()) {
+            if (tok->varId())
+                uses[tok->varId()].push_back(tok);
+
+            // function call: checkScope() looks at the first token of the 1st, 2nd and 3rd argument
+            if (Token::Match(tok, "%var% (")) {
+                unsigned int varids[3] = { 0, 0, 0 };
+                const Token *arg = tok->tokAt(2);
+                for (int argnr = 0; argnr < 3 && arg; ++argnr, arg = arg->nextArgument()) {
+                    const unsigned int varid = arg->varId();
+                    if (varid && varid != tok->varId() && std::find(varids, varids + argnr, varid) == varids + argnr)
+                        uses[varid].push_back(tok);
+                    varids[argnr] = varid;
+                }
+            }
+        }
+    }
+}
+
+const std::vector<const Token *> *CheckBufferOverrun::findArrayUses(const Scope *functionScope, unsigned int varid) const
+{
+    static const std::vector<const Token *> noUses;
+    const auto scopeUses = arrayUses.find(functionScope);
+    if (scopeUses == arrayUses.end())
+        return nullptr;
+    const auto uses = scopeUses->second.find(varid);
+    return uses == scopeUses->second.end() ? &noUses : &uses->second;
+}
+
 void CheckBufferOverrun::bufferOverrun()
 {
+    createArrayUseIndex();
     checkGlobalAndLocalVariable();
     checkStructVariable();
     checkBufferAllocatedWithStrlen();
@@ -1621,7 +1690,10 @@ void CheckBufferOverrun::checkStringArgument()
     for (std::size_t functionIndex = 0; functionIndex < functions; ++functionIndex) {
         const Scope * const scope = symbolDatabase->functionScopes[functionIndex];
         for (const Token *tok = scope->classStart; tok != scope->classEnd; tok = tok->next()) {
-            if (!Token::Match(tok, "%var% (") || !_settings->library.hasminsize(tok->str()))
+            if (!Token::Match(tok, "%var% ("))
+                continue;
+            const Library::FunctionDescriptor *libfunc = _settings->library.descriptor(tok->str());
+            if (!libfunc || !libfunc->hasminsize)
                 continue;
 
             unsigned int argnr = 1;
@@ -1631,7 +1703,7 @@ void CheckBufferOverrun::checkStringArgument()
                 const Token *strtoken = argtok->getValueTokenMinStrSize();
                 if (!strtoken)
                     continue;
-                const std::list<Library::ArgumentChecks::MinSize> *minsizes = _settings->library.argminsizes(tok->str(), argnr);
+                const std::list<Library::ArgumentChecks::MinSize> *minsizes = libfunc->argminsizes(argnr);
                 if (!minsizes)
                     continue;
                 if (checkMinSizes(*minsizes, tok, Token::getStrSize(strtoken), nullptr))
@@ -1899,8 +1971,8 @@ Check::FileInfo* CheckBufferOverrun::getFileInfo(const Tokenizer *tokenizer, con
     }
 
     // Arrays..
-    const std::list<Variable> &varlist = symbolDatabase->scopeList.front().varlist;
-    for (std::list<Variable>::const_iterator it = varlist.begin(); it != varlist.end(); ++it) {
+    const std::deque<Variable> &varlist = symbolDatabase->scopeList.front().varlist;
+    for (std::deque<Variable>::const_iterator it = varlist.begin(); it != varlist.end(); ++it) {
         const Variable &var = *it;
         if (!var.isStatic() && var.isArray() && var.dimensions().size() == 1U)
             fileInfo->arraySize[var.name()] = var.dimension(0U);
@@ -28,7 +28,9 @@
 #include <list>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
+class Scope;
 class Variable;
 
 /// @addtogroup Checks
@@ -42,6 +44,10 @@ class Variable;
  * index is out of bounds.
  * I generally use 'buffer overrun' if you for example call a strcpy or
  * other function and pass a buffer and reads or writes too much data.
+ *
+ * The uses of each variable in the function bodies (the variable itself and
+ * the function calls it is passed to) are indexed once, so checkScope() only
+ * needs to visit those tokens for a local array.
  */
 class CPPCHECKLIB CheckBufferOverrun : public Check {
 public:
@@ -100,6 +106,9 @@ public:
     /** Check for buffer overruns - locate global variables and local function variables and check them with the checkScope function */
     void checkGlobalAndLocalVariable();
 
+    /** Index the uses of the variables in the function bodies */
+    void createArrayUseIndex();
+
     /** Check for buffer overruns due to allocating strlen(src) bytes instead of (strlen(src)+1) bytes before copying a string */
     void checkBufferAllocatedWithStrlen();
 
@@ -174,8 +183,17 @@ public:
         }
     };
 
-    /** Check for buffer overruns (based on ArrayInfo) */
-    void checkScope(const Token *tok, const ArrayInfo &arrayInfo);
+    /**
+     * Check for buffer overruns (based on ArrayInfo)
+     * @param tok first token to check, the rest of its scope is checked
+     * @param arrayInfo the array information
+     * @param uses if given, only these tokens are checked after tok
+     * @param firstUse index of the first use after tok
+     */
+    void checkScope(const Token *tok, const ArrayInfo &arrayInfo, const std::vector<const Token *> *uses = nullptr, std::size_t firstUse = 0);
+
+    /** Indexed uses of a variable in a function body, nullptr if the function body is not indexed */
+    const std::vector<const Token *> *findArrayUses(const Scope *functionScope, unsigned int varid) const;
 
     /** Check for buffer overruns */
     void checkScope(const Token *tok, const std::vector<std::string> &varname, const ArrayInfo &arrayInfo);
@@ -226,6 +244,12 @@ public:
     void analyseWholeProgram(const std::list<Check::FileInfo*> &fileInfo, ErrorLogger &errorLogger);
 
 private:
+    /**
+     * Tokens in each function body that use a variable, in token order:
+     * the variable itself and the function calls with the variable as
+     * first token of the 1st, 2nd or 3rd argument
+     */
+    std::unordered_map<const Scope *, std::unordered_map<unsigned int, std::vector<const Token *> > > arrayUses;
 
     static bool isArrayOfStruct(const Token* tok, int &position);
     void arrayIndexOutOfBoundsError(const std::list<const Token *> &callstack, const ArrayInfo &arrayInfo, const std::vector<MathLib::bigint> &index);
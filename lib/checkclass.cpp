@@ -64,9 +64,52 @@ namespace {
 
 CheckClass::CheckClass(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
     : Check(myName(), tokenizer, settings, errorLogger),
-      symbolDatabase(tokenizer?tokenizer->getSymbolDatabase():nullptr)
+      symbolDatabase(tokenizer?tokenizer->getSymbolDatabase():nullptr),
+      sharedMemberIndexes(&memberIndexes)
 {
+    if (!symbolDatabase)
+        return;
+
+    for (auto scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
+        if (scope->isClassOrStruct() || scope->type == Scope::eUnion)
+            memberIndexes.insert(std::make_pair(&*scope, MemberIndex(&*scope)));
+    }
+}
+
+CheckClass::CheckClass(const CheckClass &check, ErrorLogger *errorLogger)
+    : Check(myName(), check._tokenizer, check._settings, errorLogger),
+      symbolDatabase(check.symbolDatabase),
+      sharedMemberIndexes(check.sharedMemberIndexes)
+{
+}
+
+CheckClass::MemberIndex::MemberIndex(const Scope *scope)
+{
+    for (auto var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
+        const std::size_t index = _variables.size();
+        _variables.push_back(&*var);
+        if (var->declarationId())
+            _varIds.insert(std::make_pair(var->declarationId(), index));
+        _names.insert(std::make_pair(var->name(), index));
+    }
+}
+
+std::size_t CheckClass::MemberIndex::find(const Token *vartok) const
+{
+    if (vartok->varId()) {
+        const auto it = _varIds.find(vartok->varId());
+        if (it != _varIds.end())
+            return it->second;
+    }
+    const auto it = _names.find(vartok->str());
+    return (it != _names.end()) ? it->second : _variables.size();
+}
 
+const CheckClass::MemberIndex &CheckClass::memberIndex(const Scope *scope) const
+{
+    static const MemberIndex noMembers;
+    const auto it = sharedMemberIndexes->find(scope);
+    return (it != sharedMemberIndexes->end()) ? it->second : noMembers;
 }
 
 //---------------------------------------------------------------------------
@@ -74,139 +117,145 @@ CheckClass::CheckClass(const Tokenizer *tokenizer, const Settings *settings, Err
 //---------------------------------------------------------------------------
 
 void CheckClass::constructors()
+{
+    if (!_settings->isEnabled("style") && !_settings->isEnabled("warning"))
+        return;
+
+    ParallelLoop loop(_errorLogger, _settings);
+    CheckClass checkClass(*this, &loop);
+    loop.forEach(symbolDatabase->classAndStructScopes.size(), &checkClass, &CheckClass::checkConstructors);
+}
+
+void CheckClass::checkConstructors(std::size_t i)
 {
     const bool style = _settings->isEnabled("style");
     const bool warnings = _settings->isEnabled("warning");
-    if (!style && !warnings)
-        return;
 
-    const std::size_t classes = symbolDatabase->classAndStructScopes.size();
-    for (std::size_t i = 0; i < classes; ++i) {
-        const Scope * scope = symbolDatabase->classAndStructScopes[i];
+    const Scope * scope = symbolDatabase->classAndStructScopes[i];
 
-        // There are no constructors.
-        if (scope->numConstructors == 0 && style) {
-            // If there is a private variable, there should be a constructor..
-            for (auto var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
-                if (var->isPrivate() && !var->isStatic() && !Token::Match(var->nameToken(), "%varid% ; %varid% =", var->declarationId()) &&
-                    (!var->isClass() || (var->type() && var->type()->needInitialization == Type::True))) {
-                    noConstructorError(scope->classDef, scope->className, scope->classDef->str() == "struct");
-                    break;
-                }
+    // There are no constructors.
+    if (scope->numConstructors == 0 && style) {
+        // If there is a private variable, there should be a constructor..
+        for (auto var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
+            if (var->isPrivate() && !var->isStatic() && !Token::Match(var->nameToken(), "%varid% ; %varid% =", var->declarationId()) &&
+                (!var->isClass() || (var->type() && var->type()->needInitialization == Type::True))) {
+                noConstructorError(scope->classDef, scope->className, scope->classDef->str() == "struct");
+                break;
             }
         }
+    }
 
-        if (!warnings)
-            continue;
+    if (!warnings)
+        return;
 
-        // #3196 => bailout if there are nested unions
-        // TODO: handle union variables better
-        {
-            bool bailout = false;
-            for (auto it = scope->nestedList.begin(); it != scope->nestedList.end(); ++it) {
-                const Scope * const nestedScope = *it;
-                if (nestedScope->type == Scope::eUnion) {
-                    bailout = true;
-                    break;
-                }
+    // #3196 => bailout if there are nested unions
+    // TODO: handle union variables better
+    {
+        bool bailout = false;
+        for (auto it = scope->nestedList.begin(); it != scope->nestedList.end(); ++it) {
+            const Scope * const nestedScope = *it;
+            if (nestedScope->type == Scope::eUnion) {
+                bailout = true;
+                break;
             }
-            if (bailout)
-                continue;
         }
+        if (bailout)
+            return;
+    }
 
-        std::vector<Usage> usage(scope->varlist.size());
+    std::vector<Usage> usage(scope->varlist.size());
+    MemberFunctionUsage memberUsage;
 
-        for (auto func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
-            if (!func->hasBody || !(func->isConstructor() ||
-                                    func->type == Function::eOperatorEqual))
-                continue;
+    for (auto func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+        if (!func->hasBody || !(func->isConstructor() ||
+                                func->type == Function::eOperatorEqual))
+            continue;
 
-            // Mark all variables not used
-            clearAllVar(usage);
+        // Mark all variables not used
+        clearAllVar(usage);
 
-            std::list<const Function *> callstack;
-            initializeVarList(*func, callstack, &(*scope), usage);
+        std::list<const Function *> callstack;
+        initializeVarList(*func, callstack, &(*scope), usage, memberUsage);
 
-            // Check if any variables are uninitialized
-            unsigned int count = 0;
-            for (auto var = scope->varlist.begin(); var != scope->varlist.end(); ++var, ++count) {
-                // check for C++11 initializer
-                if (var->hasDefault()) {
-                    usage[count].init = true;
-                    continue;
-                }
+        // Check if any variables are uninitialized
+        unsigned int count = 0;
+        for (auto var = scope->varlist.begin(); var != scope->varlist.end(); ++var, ++count) {
+            // check for C++11 initializer
+            if (var->hasDefault()) {
+                usage[count].init = true;
+                continue;
+            }
 
-                if (usage[count].assign || usage[count].init || var->isStatic())
+            if (usage[count].assign || usage[count].init || var->isStatic())
+                continue;
+
+            if (var->isConst() && func->isOperator) // We can't set const members in assignment operator
+                continue;
+
+            // Check if this is a class constructor
+            if (!var->isPointer() && var->isClass() && func->type == Function::eConstructor) {
+                // Unknown type so assume it is initialized
+                if (!var->type())
                     continue;
 
-                if (var->isConst() && func->isOperator) // We can't set const members in assignment operator
+                // Known type that doesn't need initialization or
+                // known type that has member variables of an unknown type
+                else if (var->type()->needInitialization != Type::True)
                     continue;
+            }
 
-                // Check if this is a class constructor
-                if (!var->isPointer() && var->isClass() && func->type == Function::eConstructor) {
-                    // Unknown type so assume it is initialized
-                    if (!var->type())
+            // Check if type can't be copied
+            if (!var->isPointer() && var->typeScope()) {
+                if (func->type == Function::eMoveConstructor) {
+                    if (canNotMove(var->typeScope()))
                         continue;
-
-                    // Known type that doesn't need initialization or
-                    // known type that has member variables of an unknown type
-                    else if (var->type()->needInitialization != Type::True)
+                } else {
+                    if (canNotCopy(var->typeScope()))
                         continue;
                 }
+            }
 
-                // Check if type can't be copied
-                if (!var->isPointer() && var->typeScope()) {
-                    if (func->type == Function::eMoveConstructor) {
-                        if (canNotMove(var->typeScope()))
-                            continue;
-                    } else {
-                        if (canNotCopy(var->typeScope()))
-                            continue;
-                    }
-                }
-
-                bool inconclusive = false;
-                // Don't warn about unknown types in copy constructors since we
-                // don't know if they can be copied or not..
-                if (!var->isPointer() &&
-                    !(var->type() && var->type()->needInitialization != Type::True) &&
-                    (func->type == Function::eCopyConstructor || func->type == Function::eOperatorEqual)) {
-                    if (!var->typeStartToken()->isStandardType()) {
-                        if (_settings->inconclusive)
-                            inconclusive = true;
-                        else
-                            continue;
-                    }
+            bool inconclusive = false;
+            // Don't warn about unknown types in copy constructors since we
+            // don't know if they can be copied or not..
+            if (!var->isPointer() &&
+                !(var->type() && var->type()->needInitialization != Type::True) &&
+                (func->type == Function::eCopyConstructor || func->type == Function::eOperatorEqual)) {
+                if (!var->typeStartToken()->isStandardType()) {
+                    if (_settings->inconclusive)
+                        inconclusive = true;
+                    else
+                        continue;
                 }
+            }
 
-                // It's non-static and it's not initialized => error
-                if (func->type == Function::eOperatorEqual) {
-                    const Token *operStart = func->arg;
+            // It's non-static and it's not initialized => error
+            if (func->type == Function::eOperatorEqual) {
+                const Token *operStart = func->arg;
 
-                    bool classNameUsed = false;
-                    for (const Token *operTok = operStart; operTok != operStart->link(); operTok = operTok->next()) {
-                        if (operTok->str() == scope->className) {
-                            classNameUsed = true;
-                            break;
-                        }
+                bool classNameUsed = false;
+                for (const Token *operTok = operStart; operTok != operStart->link(); operTok = operTok->next()) {
+                    if (operTok->str() == scope->className) {
+                        classNameUsed = true;
+                        break;
                     }
+                }
 
-                    if (classNameUsed)
-                        operatorEqVarError(func->token, scope->className, var->name(), inconclusive);
-                } else if (func->access != Private) {
-                    const Scope *varType = var->typeScope();
-                    if (!varType || varType->type != Scope::eUnion) {
-                        if (func->type == Function::eConstructor &&
-                            func->nestedIn && (func->nestedIn->numConstructors - func->nestedIn->numCopyOrMoveConstructors) > 1 &&
-                            func->argCount() == 0 && func->functionScope &&
-                            func->arg && func->arg->link()->next() == func->functionScope->classStart &&
-                            func->functionScope->classStart->link() == func->functionScope->classStart->next()) {
-                            // don't warn about user defined default constructor when there are other constructors
-                            if (_settings->inconclusive)
-                                uninitVarError(func->token, scope->className, var->name(), true);
-                        } else
-                            uninitVarError(func->token, scope->className, var->name(), inconclusive);
-                    }
+                if (classNameUsed)
+                    operatorEqVarError(func->token, scope->className, var->name(), inconclusive);
+            } else if (func->access != Private) {
+                const Scope *varType = var->typeScope();
+                if (!varType || varType->type != Scope::eUnion) {
+                    if (func->type == Function::eConstructor &&
+                        func->nestedIn && (func->nestedIn->numConstructors - func->nestedIn->numCopyOrMoveConstructors) > 1 &&
+                        func->argCount() == 0 && func->functionScope &&
+                        func->arg && func->arg->link()->next() == func->functionScope->classStart &&
+                        func->functionScope->classStart->link() == func->functionScope->classStart->next()) {
+                        // don't warn about user defined default constructor when there are other constructors
+                        if (_settings->inconclusive)
+                            uninitVarError(func->token, scope->className, var->name(), true);
+                    } else
+                        uninitVarError(func->token, scope->className, var->name(), inconclusive);
                 }
             }
         }
@@ -358,28 +407,18 @@ bool CheckClass::canNotMove(const Scope *scope)
     return constructor && !(publicAssign || publicCopy || publicMove);
 }
 
-void CheckClass::assignVar(const std::string &varname, const Scope *scope, std::vector<Usage> &usage)
+void CheckClass::assignVar(const Token *vartok, const MemberIndex &members, std::vector<Usage> &usage)
 {
-    unsigned int count = 0;
-
-    for (auto var = scope->varlist.begin(); var != scope->varlist.end(); ++var, ++count) {
-        if (var->name() == varname) {
-            usage[count].assign = true;
-            return;
-        }
-    }
+    const std::size_t index = members.find(vartok);
+    if (index < usage.size())
+        usage[index].assign = true;
 }
 
-void CheckClass::initVar(const std::string &varname, const Scope *scope, std::vector<Usage> &usage)
+void CheckClass::initVar(const Token *vartok, const MemberIndex &members, std::vector<Usage> &usage)
 {
-    unsigned int count = 0;
-
-    for (auto var = scope->varlist.begin(); var != scope->varlist.end(); ++var, ++count) {
-        if (var->name() == varname) {
-            usage[count].init = true;
-            return;
-        }
-    }
+    const std::size_t index = members.find(vartok);
+    if (index < usage.size())
+        usage[index].init = true;
 }
 
 void CheckClass::assignAllVar(std::vector<Usage> &usage)
@@ -404,8 +443,8 @@ bool CheckClass::isBaseClassFunc(const Token *tok, const Scope *scope)
 
         // Check if base class exists in database
         if (derivedFrom && derivedFrom->classScope) {
-            const std::list<Function>& functionList = derivedFrom->classScope->functionList;
-            std::list<Function>::const_iterator func;
+            const std::deque<Function>& functionList = derivedFrom->classScope->functionList;
+            std::deque<Function>::const_iterator func;
 
             for (func = functionList.begin(); func != functionList.end(); ++func) {
                 if (func->tokenDef->str() == tok->str())
@@ -421,10 +460,38 @@ bool CheckClass::isBaseClassFunc(const Token *tok, const Scope *scope)
     return false;
 }
 
-void CheckClass::initializeVarList(const Function &func, std::list<const Function *> &callstack, const Scope *scope, std::vector<Usage> &usage)
+bool CheckClass::initializeVarListOfMember(const Function &member, std::list<const Function *> &callstack, const Scope *scope, std::vector<Usage> &usage, MemberFunctionUsage &memberUsage)
+{
+    const auto parsed = memberUsage.find(&member);
+    if (parsed != memberUsage.end()) {
+        for (std::size_t i = 0; i < usage.size(); ++i) {
+            usage[i].assign |= parsed->second[i].assign;
+            usage[i].init |= parsed->second[i].init;
+        }
+        return true;
+    }
+
+    // the usage of a member function doesn't depend on the caller unless there is recursion
+    std::vector<Usage> memberFunctionUsage(usage.size());
+    callstack.push_back(&member);
+    const bool noRecursion = initializeVarList(member, callstack, scope, memberFunctionUsage, memberUsage);
+    callstack.pop_back();
+
+    for (std::size_t i = 0; i < usage.size(); ++i) {
+        usage[i].assign |= memberFunctionUsage[i].assign;
+        usage[i].init |= memberFunctionUsage[i].init;
+    }
+    if (noRecursion)
+        memberUsage[&member].swap(memberFunctionUsage);
+    return noRecursion;
+}
+
+bool CheckClass::initializeVarList(const Function &func, std::list<const Function *> &callstack, const Scope *scope, std::vector<Usage> &usage, MemberFunctionUsage &memberUsage)
 {
     if (!func.functionScope)
         throw InternalError(0, "Internal Error: Invalid syntax"); // #5702
+    const MemberIndex &members = memberIndex(scope);
+    bool noRecursion = true;
     bool initList = func.isConstructor();
     const Token *ftok = func.arg->link()->next();
     int level = 0;
@@ -434,7 +501,7 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
         if (initList) {
             if (level == 0 && Token::Match(ftok, "%var% {|(")) {
                 if (ftok->str() != func.name()) {
-                    initVar(ftok->str(), scope, usage);
+                    initVar(ftok, members, usage);
                 } else { // c++11 delegate constructor
                     const Function *member = ftok->function();
                     // member function found
@@ -444,15 +511,13 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
                         if (std::find(callstack.begin(), callstack.end(), member) != callstack.end()) {
                             /** @todo false negative: just bail */
                             assignAllVar(usage);
-                            return;
+                            return false;
                         }
 
                         // member function has implementation
                         if (member->hasBody) {
                             // initialize variable use list using member function
-                            callstack.push_back(member);
-                            initializeVarList(*member, callstack, scope, usage);
-                            callstack.pop_back();
+                            noRecursion &= initializeVarListOfMember(*member, callstack, scope, usage, memberUsage);
                         }
 
                         // there is a called member function, but it has no implementation, so we assume it initializes everything
@@ -464,7 +529,7 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
                 ftok = ftok->next();
                 level++;
             } else if (level != 0 && Token::Match(ftok, "%var% =")) // assignment in the initializer: var(value = x)
-                assignVar(ftok->str(), scope, usage);
+                assignVar(ftok, members, usage);
 
             else if (ftok->str() == "(")
                 level++;
@@ -483,7 +548,7 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
 
         // Variable getting value from stream?
         if (Token::Match(ftok, ">> %var%")) {
-            assignVar(ftok->strAt(1), scope, usage);
+            assignVar(ftok->next(), members, usage);
         }
 
         // Before a new statement there is "[{};()=[]"
@@ -507,12 +572,10 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
 
         // Calling member variable function?
         if (Token::Match(ftok->next(), "%var% . %var% (")) {
-            for (auto var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
-                if (var->declarationId() == ftok->next()->varId()) {
-                    /** @todo false negative: we assume function changes variable state */
-                    assignVar(ftok->next()->str(), scope, usage);
-                    break;
-                }
+            const std::size_t index = members.find(ftok->next());
+            if (index < members.size() && members.variable(index)->declarationId() == ftok->next()->varId()) {
+                /** @todo false negative: we assume function changes variable state */
+                assignVar(ftok->next(), members, usage);
             }
 
             ftok = ftok->tokAt(2);
@@ -549,14 +612,14 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
         // Clearing all variables..
         if (Token::Match(ftok, "::| memset ( this ,")) {
             assignAllVar(usage);
-            return;
+            return noRecursion;
         }
 
         // Clearing array..
         else if (Token::Match(ftok, "::| memset ( %var% ,")) {
             if (ftok->str() == "::")
                 ftok = ftok->next();
-            assignVar(ftok->strAt(2), scope, usage);
+            assignVar(ftok->tokAt(2), members, usage);
             ftok = ftok->linkAt(1);
             continue;
         }
@@ -571,15 +634,13 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
                 if (std::find(callstack.begin(), callstack.end(), member) != callstack.end()) {
                     /** @todo false negative: just bail */
                     assignAllVar(usage);
-                    return;
+                    return false;
                 }
 
                 // member function has implementation
                 if (member->hasBody) {
                     // initialize variable use list using member function
-                    callstack.push_back(member);
-                    initializeVarList(*member, callstack, scope, usage);
-                    callstack.pop_back();
+                    noRecursion &= initializeVarListOfMember(*member, callstack, scope, usage, memberUsage);
                 }
 
                 // there is a called member function, but it has no implementation, so we assume it initializes everything
@@ -600,7 +661,7 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
             for (const Token *tok2 = ftok->next()->link(); tok2 && tok2 != ftok; tok2 = tok2->previous()) {
                 if (tok2->str() == "this") {
                     assignAllVar(usage);
-                    return;
+                    return noRecursion;
                 }
             }
 
@@ -613,15 +674,13 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
                 // assume that all variables are initialized
                 if (std::find(callstack.begin(), callstack.end(), member) != callstack.end()) {
                     assignAllVar(usage);
-                    return;
+                    return false;
                 }
 
                 // member function has implementation
                 if (member->hasBody) {
                     // initialize variable use list using member function
-                    callstack.push_back(member);
-                    initializeVarList(*member, callstack, scope, usage);
-                    callstack.pop_back();
+                    noRecursion &= initializeVarListOfMember(*member, callstack, scope, usage, memberUsage);
 
                     // Assume that variables that are passed to it are initialized..
                     for (const Token *tok2 = ftok; tok2; tok2 = tok2->next()) {
@@ -631,7 +690,7 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
                             tok2 = tok2->next();
                             if (tok2->str() == "&")
                                 tok2 = tok2->next();
-                            assignVar(tok2->str(), scope, usage);
+                            assignVar(tok2, members, usage);
                         }
                     }
                 }
@@ -661,7 +720,7 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
                 else {
                     for (const Token *tok = ftok->tokAt(2); tok && tok != ftok->next()->link(); tok = tok->next()) {
                         if (tok->isName()) {
-                            assignVar(tok->str(), scope, usage);
+                            assignVar(tok, members, usage);
                         }
                     }
                 }
@@ -670,7 +729,7 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
 
         // Assignment of member variable?
         else if (Token::Match(ftok, "%var% =")) {
-            assignVar(ftok->str(), scope, usage);
+            assignVar(ftok, members, usage);
         }
 
         // Assignment of array item of member variable?
@@ -685,21 +744,23 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
                     break;
             }
             if (tok2 && tok2->strAt(1) == "=")
-                assignVar(ftok->str(), scope, usage);
+                assignVar(ftok, members, usage);
         }
 
         // Assignment of array item of member variable?
         else if (Token::Match(ftok, "* %var% =")) {
-            assignVar(ftok->next()->str(), scope, usage);
+            assignVar(ftok->next(), members, usage);
         } else if (Token::Match(ftok, "* this . %var% =")) {
-            assignVar(ftok->strAt(3), scope, usage);
+            assignVar(ftok->tokAt(3), members, usage);
         }
 
         // The functions 'clear' and 'Clear' are supposed to initialize variable.
         if (Token::Match(ftok, "%var% . clear|Clear (")) {
-            assignVar(ftok->str(), scope, usage);
+            assignVar(ftok, members, usage);
         }
     }
+
+    return noRecursion;
 }
 
 void CheckClass::noConstructorError(const Token *tok, const std::string &classname, bool isStruct)
@@ -823,7 +884,7 @@ static bool checkFunctionUsage(const std::string& name, const Scope* scope)
                 return true;
     }
 
-    for (std::list<Variable>::const_iterator i = scope->varlist.begin(); i != scope->varlist.end(); ++i) {
+    for (std::deque<Variable>::const_iterator i = scope->varlist.begin(); i != scope->varlist.end(); ++i) {
         if (i->isStatic()) {
             const Token* tok = Token::findmatch(scope->classEnd, "%varid% =|(|{", i->declarationId());
             if (tok)
@@ -1540,75 +1601,79 @@ void CheckClass::checkConst()
     if (!_settings->isEnabled("style"))
         return;
 
-    const std::size_t classes = symbolDatabase->classAndStructScopes.size();
-    for (std::size_t i = 0; i < classes; ++i) {
-        const Scope * scope = symbolDatabase->classAndStructScopes[i];
+    ParallelLoop loop(_errorLogger, _settings);
+    CheckClass checkClass(*this, &loop);
+    loop.forEach(symbolDatabase->classAndStructScopes.size(), &checkClass, &CheckClass::checkConstClass);
+}
 
-        for (auto func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
-            // does the function have a body?
-            if (func->type == Function::eFunction && func->hasBody && !func->isFriend && !func->isStatic && !func->isVirtual) {
-                // get last token of return type
-                const Token *previous = func->tokenDef->previous();
-
-                // does the function return a pointer or reference?
-                if (Token::Match(previous, "*|&")) {
-                    if (func->retDef->str() != "const")
-                        continue;
-                } else if (Token::Match(previous->previous(), "*|& >")) {
-                    const Token *temp = previous;
-
-                    bool foundConst = false;
-                    while (!Token::Match(temp->previous(), ";|}|{|public:|protected:|private:")) {
-                        temp = temp->previous();
-                        if (temp->str() == "const") {
-                            foundConst = true;
-                            break;
-                        }
-                    }
+void CheckClass::checkConstClass(std::size_t i)
+{
+    const Scope * scope = symbolDatabase->classAndStructScopes[i];
 
-                    if (!foundConst)
-                        continue;
-                } else if (func->isOperator && Token::Match(previous, ";|{|}|public:|private:|protected:")) { // Operator without return type: conversion operator
-                    const std::string& opName = func->tokenDef->str();
-                    if (opName.compare(8, 5, "const") != 0 && opName[opName.size()-1] == '&')
-                        continue;
-                } else {
-                    // don't warn for unknown types..
-                    // LPVOID, HDC, etc
-                    if (previous->isUpperCaseName() && previous->str().size() > 2 && !symbolDatabase->isClassOrStruct(previous->str()))
-                        continue;
+    for (auto func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+        // does the function have a body?
+        if (func->type == Function::eFunction && func->hasBody && !func->isFriend && !func->isStatic && !func->isVirtual) {
+            // get last token of return type
+            const Token *previous = func->tokenDef->previous();
+
+            // does the function return a pointer or reference?
+            if (Token::Match(previous, "*|&")) {
+                if (func->retDef->str() != "const")
+                    continue;
+            } else if (Token::Match(previous->previous(), "*|& >")) {
+                const Token *temp = previous;
+
+                bool foundConst = false;
+                while (!Token::Match(temp->previous(), ";|}|{|public:|protected:|private:")) {
+                    temp = temp->previous();
+                    if (temp->str() == "const") {
+                        foundConst = true;
+                        break;
+                    }
                 }
 
-                // check if base class function is virtual
-                if (!scope->definedType->derivedFrom.empty()) {
-                    if (func->isImplicitlyVirtual(true))
-                        continue;
-                }
+                if (!foundConst)
+                    continue;
+            } else if (func->isOperator && Token::Match(previous, ";|{|}|public:|private:|protected:")) { // Operator without return type: conversion operator
+                const std::string& opName = func->tokenDef->str();
+                if (opName.compare(8, 5, "const") != 0 && opName[opName.size()-1] == '&')
+                    continue;
+            } else {
+                // don't warn for unknown types..
+                // LPVOID, HDC, etc
+                if (previous->isUpperCaseName() && previous->str().size() > 2 && !symbolDatabase->isClassOrStruct(previous->str()))
+                    continue;
+            }
 
-                bool memberAccessed = false;
-                // if nothing non-const was found. write error..
-                if (checkConstFunc(&(*scope), &*func, memberAccessed)) {
-                    std::string classname = scope->className;
-                    const Scope *nest = scope->nestedIn;
-                    while (nest && nest->type != Scope::eGlobal) {
-                        classname = std::string(nest->className + "::" + classname);
-                        nest = nest->nestedIn;
-                    }
+            // check if base class function is virtual
+            if (!scope->definedType->derivedFrom.empty()) {
+                if (func->isImplicitlyVirtual(true))
+                    continue;
+            }
 
-                    // get function name
-                    std::string functionName = (func->tokenDef->isName() ? "" : "operator") + func->tokenDef->str();
+            bool memberAccessed = false;
+            // if nothing non-const was found. write error..
+            if (checkConstFunc(&(*scope), &*func, memberAccessed)) {
+                std::string classname = scope->className;
+                const Scope *nest = scope->nestedIn;
+                while (nest && nest->type != Scope::eGlobal) {
+                    classname = std::string(nest->className + "::" + classname);
+                    nest = nest->nestedIn;
+                }
 
-                    if (func->tokenDef->str() == "(")
-                        functionName += ")";
-                    else if (func->tokenDef->str() == "[")
-                        functionName += "]";
+                // get function name
+                std::string functionName = (func->tokenDef->isName() ? "" : "operator") + func->tokenDef->str();
 
-                    if (!func->isConst || (!memberAccessed && !func->isOperator)) {
-                        if (func->isInline)
-                            checkConstError(func->token, classname, functionName, !memberAccessed && !func->isOperator);
-                        else // not inline
-                            checkConstError2(func->token, func->tokenDef, classname, functionName, !memberAccessed && !func->isOperator);
-                    }
+                if (func->tokenDef->str() == "(")
+                    functionName += ")";
+                else if (func->tokenDef->str() == "[")
+                    functionName += "]";
+
+                if (!func->isConst || (!memberAccessed && !func->isOperator)) {
+                    if (func->isInline)
+                        checkConstError(func->token, classname, functionName, !memberAccessed && !func->isOperator);
+                    else // not inline
+                        checkConstError2(func->token, func->tokenDef, classname, functionName, !memberAccessed && !func->isOperator);
                 }
             }
         }
@@ -1639,13 +1704,13 @@ bool CheckClass::isMemberVar(const Scope *scope, const Token *tok) const
         }
     } while (again);
 
-    for (auto var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
-        if (var->name() == tok->str()) {
-            if (tok->varId() == 0)
-                symbolDatabase->debugMessage(tok, "CheckClass::isMemberVar found used member variable \'" + tok->str() + "\' with varid 0");
+    const MemberIndex &members = memberIndex(scope);
+    const std::size_t index = members.find(tok);
+    if (index < members.size()) {
+        if (tok->varId() == 0)
+            symbolDatabase->debugMessage(tok, "CheckClass::isMemberVar found used member variable \'" + tok->str() + "\' with varid 0");
 
-            return !var->isStatic();
-        }
+        return !members.variable(index)->isStatic();
     }
 
     // not found in this class
@@ -2112,7 +2177,7 @@ void CheckClass::checkDuplInheritedMembers()
         return;
 
     // Iterate over all classes
-    for (std::list<Type>::const_iterator classIt = symbolDatabase->typeList.begin();
+    for (std::deque<Type>::const_iterator classIt = symbolDatabase->typeList.begin();
          classIt != symbolDatabase->typeList.end();
          ++classIt) {
         // Iterate over the parent classes
@@ -2123,10 +2188,10 @@ void CheckClass::checkDuplInheritedMembers()
             if (!parentClassIt->type || !parentClassIt->type->classScope)
                 continue;
             // Check if they have a member variable in common
-            for (std::list<Variable>::const_iterator classVarIt = classIt->classScope->varlist.begin();
+            for (std::deque<Variable>::const_iterator classVarIt = classIt->classScope->varlist.begin();
                  classVarIt != classIt->classScope->varlist.end();
                  ++classVarIt) {
-                for (std::list<Variable>::const_iterator parentClassVarIt = parentClassIt->type->classScope->varlist.begin();
+                for (std::deque<Variable>::const_iterator parentClassVarIt = parentClassIt->type->classScope->varlist.begin();
                      parentClassVarIt != parentClassIt->type->classScope->varlist.end();
                      ++parentClassVarIt) {
                     if (classVarIt->name() == parentClassVarIt->name() && !parentClassVarIt->isPrivate()) { // Check if the class and its parent have a common variable
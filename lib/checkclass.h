@@ -35,7 +35,7 @@ class Function;
 class CPPCHECKLIB CheckClass : public Check {
 public:
     /** @brief This constructor is used when registering the CheckClass */
-    CheckClass() : Check(myName()), symbolDatabase(NULL) {
+    CheckClass() : Check(myName()), symbolDatabase(NULL), sharedMemberIndexes(NULL) {
     }
 
     /** @brief This constructor is used when running checks. */
@@ -132,6 +132,9 @@ public:
     void checkDuplInheritedMembers();
 
 private:
+    /** @brief This constructor is used by the parallel loops, the member indexes of check are shared */
+    CheckClass(const CheckClass &check, ErrorLogger *errorLogger);
+
     const SymbolDatabase *symbolDatabase;
 
     // Reporting errors..
@@ -226,6 +229,47 @@ private:
     bool isConstMemberFunc(const Scope *scope, const Token *tok) const;
     bool checkConstFunc(const Scope *scope, const Function *func, bool& memberAccessed) const;
 
+    /** @brief Positions of the member variables of a class in its Scope::varlist */
+    class MemberIndex {
+    public:
+        MemberIndex() {
+        }
+
+        explicit MemberIndex(const Scope *scope);
+
+        /** @brief number of member variables */
+        std::size_t size() const {
+            return _variables.size();
+        }
+
+        /** @brief the member variable at position index */
+        const Variable *variable(std::size_t index) const {
+            return _variables[index];
+        }
+
+        /**
+         * @brief position of the member variable a token refers to
+         * The varid of the token is looked up first, then its name.
+         * @param vartok name token
+         * @return position of the member variable or size() if there is none
+         */
+        std::size_t find(const Token *vartok) const;
+
+    private:
+        std::vector<const Variable *> _variables;
+        std::map<unsigned int, std::size_t> _varIds;
+        std::map<std::string, std::size_t> _names;
+    };
+
+    /** @brief The member index of a class scope, it is empty for other scopes */
+    const MemberIndex &memberIndex(const Scope *scope) const;
+
+    /** @brief Member indexes of the classes, built once and shared by the checks */
+    std::map<const Scope *, MemberIndex> memberIndexes;
+
+    /** @brief memberIndexes of this check or of the check that runs a parallel loop */
+    const std::map<const Scope *, MemberIndex> *sharedMemberIndexes;
+
     // constructors helper function
     /** @brief Information about a member variable. Used when checking for uninitialized variables */
     struct Usage {
@@ -240,21 +284,24 @@ private:
 
     static bool isBaseClassFunc(const Token *tok, const Scope *scope);
 
+    /** @brief Usage of the member variables by the member functions that have been parsed */
+    typedef std::map<const Function *, std::vector<Usage> > MemberFunctionUsage;
+
     /**
      * @brief assign a variable in the varlist
-     * @param varname name of variable to mark assigned
-     * @param scope pointer to variable Scope
+     * @param vartok name token of variable to mark assigned
+     * @param members index of the member variables
      * @param usage reference to usage vector
      */
-    static void assignVar(const std::string &varname, const Scope *scope, std::vector<Usage> &usage);
+    static void assignVar(const Token *vartok, const MemberIndex &members, std::vector<Usage> &usage);
 
     /**
      * @brief initialize a variable in the varlist
-     * @param varname name of variable to mark initialized
-     * @param scope pointer to variable Scope
+     * @param vartok name token of variable to mark initialized
+     * @param members index of the member variables
      * @param usage reference to usage vector
      */
-    static void initVar(const std::string &varname, const Scope *scope, std::vector<Usage> &usage);
+    static void initVar(const Token *vartok, const MemberIndex &members, std::vector<Usage> &usage);
 
     /**
      * @brief set all variables in list assigned
@@ -274,8 +321,23 @@ private:
      * @param callstack the function doesn't look into recursive function calls.
      * @param scope pointer to variable Scope
      * @param usage reference to usage vector
+     * @param memberUsage usage of the called member functions, filled in as they are parsed
+     * @return false if a recursive call was found, the usage then depends on the callstack
      */
-    void initializeVarList(const Function &func, std::list<const Function *> &callstack, const Scope *scope, std::vector<Usage> &usage);
+    bool initializeVarList(const Function &func, std::list<const Function *> &callstack, const Scope *scope, std::vector<Usage> &usage, MemberFunctionUsage &memberUsage);
+
+    /**
+     * @brief set the flags of the variables that a called member function initializes
+     * The usage of the member function is parsed once and reused for later calls.
+     * @return false if a recursive call was found
+     */
+    bool initializeVarListOfMember(const Function &member, std::list<const Function *> &callstack, const Scope *scope, std::vector<Usage> &usage, MemberFunctionUsage &memberUsage);
+
+    /** @brief %Check the constructors of the i'th class in classAndStructScopes */
+    void checkConstructors(std::size_t i);
+
+    /** @brief %Check which member functions of the i'th class in classAndStructScopes can be const */
+    void checkConstClass(std::size_t i);
 
     /**
      * @brief gives a list of tokens where pure virtual functions are called directly or indirectly
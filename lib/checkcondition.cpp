@@ -252,13 +252,13 @@ void CheckCondition::comparisonError(const Token *tok, const std::string &bitop,
     reportError(tok, Severity::style, "comparisonError", errmsg);
 }
 
-static bool isOverlappingCond(const Token * const cond1, const Token * const cond2, const std::set<std::string> &constFunctions)
+static bool isOverlappingCond(const Token * const cond1, const Token * const cond2, ExpressionHashes &expressions)
 {
     if (!cond1 || !cond2)
         return false;
 
     // same expressions
-    if (isSameExpression(cond1,cond2,constFunctions))
+    if (expressions.isSameExpression(cond1,cond2))
         return true;
 
     // bitwise overlap for example 'x&7' and 'x==1'
@@ -281,7 +281,7 @@ static bool isOverlappingCond(const Token * const cond1, const Token * const con
         if (!num2->isNumber() || MathLib::isNegative(num2->str()))
             return false;
 
-        if (!isSameExpression(expr1,expr2,constFunctions))
+        if (!expressions.isSameExpression(expr1,expr2))
             return false;
 
         const MathLib::bigint value1 = MathLib::toLongNumber(num1->str());
@@ -299,24 +299,66 @@ void CheckCondition::multiCondition()
 
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
 
-    for (std::list<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
+    ExpressionHashes expressions(_settings->library.functionpure);
+
+    // The '(' of each 'if (..) {..} else { if (..' in a chain, and the
+    // positions of the conditions by hash. A condition only needs to be
+    // compared with the later conditions in its chain that have the same hash.
+    struct ElseIfChain {
+        std::vector<const Token *> ifs;
+        std::unordered_map<std::size_t, std::vector<std::size_t> > sameHash;
+    };
+    std::list<ElseIfChain> chains;
+    std::unordered_map<const Token *, std::pair<const ElseIfChain *, std::size_t> > chainPosition;
+
+    for (std::deque<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
         if (i->type != Scope::eIf || !Token::simpleMatch(i->classDef, "if ("))
             continue;
 
         const Token * const cond1 = i->classDef->next()->astOperand2();
+        if (!cond1)
+            continue;
 
-        const Token * tok2 = i->classDef->next();
-        while (tok2) {
-            tok2 = tok2->link();
-            if (!Token::simpleMatch(tok2, ") {"))
-                break;
-            tok2 = tok2->linkAt(1);
-            if (!Token::simpleMatch(tok2, "} else { if ("))
-                break;
-            tok2 = tok2->tokAt(4);
+        std::unordered_map<const Token *, std::pair<const ElseIfChain *, std::size_t> >::const_iterator pos = chainPosition.find(i->classDef->next());
+        if (pos == chainPosition.end()) {
+            chains.push_back(ElseIfChain());
+            ElseIfChain &chain = chains.back();
+            const Token * tok2 = i->classDef->next();
+            while (tok2) {
+                chainPosition[tok2] = std::make_pair(&chain, chain.ifs.size());
+                if (tok2->astOperand2())
+                    chain.sameHash[expressions.hash(tok2->astOperand2())].push_back(chain.ifs.size());
+                chain.ifs.push_back(tok2);
+
+                tok2 = tok2->link();
+                if (!Token::simpleMatch(tok2, ") {"))
+                    break;
+                tok2 = tok2->linkAt(1);
+                if (!Token::simpleMatch(tok2, "} else { if ("))
+                    break;
+                tok2 = tok2->tokAt(4);
+            }
+            pos = chainPosition.find(i->classDef->next());
+        }
+
+        const ElseIfChain &chain = *pos->second.first;
+        const std::size_t first = pos->second.second + 1U;
 
-            if (isOverlappingCond(cond1, tok2->astOperand2(), _settings->library.functionpure))
-                multiConditionError(tok2, cond1->linenr());
+        if (cond1->str() == "&") {
+            // bitwise overlap for example 'x&7' and 'x==1', compare with all later conditions
+            for (std::size_t j = first; j < chain.ifs.size(); ++j) {
+                if (isOverlappingCond(cond1, chain.ifs[j]->astOperand2(), expressions))
+                    multiConditionError(chain.ifs[j], cond1->linenr());
+            }
+        } else {
+            const std::unordered_map<std::size_t, std::vector<std::size_t> >::const_iterator same = chain.sameHash.find(expressions.hash(cond1));
+            if (same == chain.sameHash.end())
+                continue;
+            for (std::size_t j = 0; j < same->second.size(); ++j) {
+                const Token * const tok2 = chain.ifs[same->second[j]];
+                if (same->second[j] >= first && isOverlappingCond(cond1, tok2->astOperand2(), expressions))
+                    multiConditionError(tok2, cond1->linenr());
+            }
         }
     }
 }
@@ -382,7 +424,7 @@ void CheckCondition::oppositeInnerCondition()
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
 
-    for (std::list<Scope>::const_iterator scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
+    for (std::deque<Scope>::const_iterator scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
         if (scope->type != Scope::eIf)
             continue;
 
@@ -60,6 +60,10 @@ public:
         checkCondition.checkModuloAlwaysTrueFalse();
     }
 
+    unsigned int severities() const {
+        return severityBit(Severity::style) | severityBit(Severity::warning);
+    }
+
     /** mismatching assignment / comparison */
     void assignIf();
 
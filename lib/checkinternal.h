@@ -56,6 +56,11 @@ public:
         checkInternal.checkExtraWhitespace();
     }
 
+    /** The pattern sets are filled when they are first used */
+    bool isThreadSafe() const {
+        return false;
+    }
+
     /** @brief %Check if a simple pattern is used inside Token::Match or Token::findmatch */
     void checkTokenMatchPatterns();
 
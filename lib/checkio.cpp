@@ -24,6 +24,7 @@
 
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
 
 //---------------------------------------------------------------------------
 
@@ -490,9 +491,13 @@ static bool findFormat(unsigned int arg, const Token *firstArg,
 }
 
 // Utility function returning whether iToTest equals iTypename or iOptionalPrefix+iTypename
-inline bool typesMatch(const std::string& iToTest, const std::string& iTypename, const std::string& iOptionalPrefix = "std::")
+static bool typesMatch(const std::string& iToTest, const char *iTypename, const char *iOptionalPrefix = "std::")
 {
-    return (iToTest == iTypename) || (iToTest == iOptionalPrefix + iTypename);
+    if (iToTest == iTypename)
+        return true;
+    const std::size_t prefixLength = std::strlen(iOptionalPrefix);
+    return iToTest.compare(0, prefixLength, iOptionalPrefix) == 0 &&
+           iToTest.compare(prefixLength, std::string::npos, iTypename) == 0;
 }
 
 void CheckIO::checkWrongPrintfScanfArguments()
@@ -509,23 +514,16 @@ void CheckIO::checkWrongPrintfScanfArguments()
 
             const Token* argListTok = 0; // Points to first va_list argument
             const Token* formatStringTok = 0; // Points to format string token
-            std::string formatString;
 
             bool scan = false;
             bool scanf_s = false;
             int formatStringArgNo = -1;
 
-            if (Token::Match(tok->next(), "( %any%") && _settings->library.formatstr_function(tok->str())) {
-                const std::map<int, Library::ArgumentChecks>& argumentChecks = _settings->library.argumentChecks.at(tok->str());
-                for (auto i = argumentChecks.begin(); i != argumentChecks.end(); ++i) {
-                    if (i->second.formatstr) {
-                        formatStringArgNo = i->first - 1;
-                        break;
-                    }
-                }
-
-                scan = _settings->library.formatstr_scan(tok->str());
-                scanf_s = _settings->library.formatstr_secure(tok->str());
+            const Library::FunctionDescriptor *libfunc = Token::Match(tok->next(), "( %any%") ? _settings->library.descriptor(tok->str()) : nullptr;
+            if (libfunc && libfunc->formatstr) {
+                formatStringArgNo = libfunc->formatstrargnr - 1;
+                scan = libfunc->formatstr_scan;
+                scanf_s = libfunc->formatstr_secure;
             }
 
             if (formatStringArgNo >= 0) {
@@ -572,10 +570,9 @@ void CheckIO::checkWrongPrintfScanfArguments()
                 continue;
             }
 
-            if (formatStringTok)
-                formatString = formatStringTok->str();
-            else
+            if (!formatStringTok)
                 continue;
+            const std::string &formatString = formatStringTok->str();
 
             // Count format string parameters..
             unsigned int numFormat = 0;
@@ -583,7 +580,7 @@ void CheckIO::checkWrongPrintfScanfArguments()
             bool percent = false;
             const Token* argListTok2 = argListTok;
             std::set<unsigned int> parameterPositionsUsed;
-            for (std::string::iterator i = formatString.begin(); i != formatString.end(); ++i) {
+            for (std::string::const_iterator i = formatString.begin(); i != formatString.end(); ++i) {
                 if (*i == '%') {
                     percent = !percent;
                 } else if (percent && *i == '[') {
@@ -1552,7 +1549,7 @@ bool CheckIO::ArgumentInfo::isStdVectorOrString()
     } else if (variableInfo->type()) {
         const Scope * classScope = variableInfo->type()->classScope;
         if (classScope) {
-            std::list<Function>::const_iterator functions;
+            std::deque<Function>::const_iterator functions;
             for (functions = classScope->functionList.begin();
                  functions != classScope->functionList.end(); ++functions) {
                 if (functions->name() == "operator[]") {
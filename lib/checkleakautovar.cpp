@@ -101,37 +101,41 @@ void CheckLeakAutoVar::configurationInfo(const Token* tok, const std::string &fu
 }
 
 void CheckLeakAutoVar::check()
+{
+    // Check function scopes, in parallel with --check-threads
+    ParallelLoop loop(_errorLogger, _settings);
+    CheckLeakAutoVar checkLeakAutoVar(_tokenizer, _settings, &loop);
+    loop.forEach(_tokenizer->getSymbolDatabase()->functionScopes.size(), &checkLeakAutoVar, &CheckLeakAutoVar::checkFunctionScope);
+}
+
+void CheckLeakAutoVar::checkFunctionScope(std::size_t i)
 {
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
+    const Scope * scope = symbolDatabase->functionScopes[i];
 
-    // Check function scopes
-    const std::size_t functions = symbolDatabase->functionScopes.size();
-    for (std::size_t i = 0; i < functions; ++i) {
-        const Scope * scope = symbolDatabase->functionScopes[i];
-        // Empty variable info
-        VarInfo varInfo;
+    // Empty variable info
+    VarInfo varInfo;
 
-        // Local variables that are known to be non-zero.
-        static const std::set<unsigned int> notzero;
+    // Local variables that are known to be non-zero.
+    static const std::set<unsigned int> notzero;
 
-        checkScope(scope->classStart, &varInfo, notzero);
+    checkScope(scope->classStart, &varInfo, notzero);
 
-        varInfo.conditionalAlloc.clear();
+    varInfo.conditionalAlloc.clear();
 
-        // Clear reference arguments from varInfo..
-        auto it = varInfo.alloctype.begin();
-        while (it != varInfo.alloctype.end()) {
-            const Variable *var = symbolDatabase->getVariableFromVarId(it->first);
-            if (!var ||
-                (var->isArgument() && var->isReference()) ||
-                (!var->isArgument() && !var->isLocal()))
-                varInfo.alloctype.erase(it++);
-            else
-                ++it;
-        }
-
-        ret(scope->classEnd, varInfo);
+    // Clear reference arguments from varInfo..
+    auto it = varInfo.alloctype.begin();
+    while (it != varInfo.alloctype.end()) {
+        const Variable *var = symbolDatabase->getVariableFromVarId(it->first);
+        if (!var ||
+            (var->isArgument() && var->isReference()) ||
+            (!var->isArgument() && !var->isLocal()))
+            varInfo.alloctype.erase(it++);
+        else
+            ++it;
     }
+
+    ret(scope->classEnd, varInfo);
 }
 
 void CheckLeakAutoVar::checkScope(const Token * const startToken,
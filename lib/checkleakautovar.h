@@ -92,6 +92,9 @@ private:
     /** check for leaks in all scopes */
     void check();
 
+    /** check for leaks in the i:th function scope */
+    void checkFunctionScope(std::size_t i);
+
     /** check for leaks in a function scope */
     void checkScope(const Token * const startToken,
                     VarInfo *varInfo,
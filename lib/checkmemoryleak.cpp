@@ -742,11 +742,21 @@ Token *CheckMemoryLeakInFunction::getcode(const Token *tok, std::list<const Toke
             if (Token::Match(tok->next(), "[{};]"))
                 continue;
 
-            // function calls are interesting..
             const Token *tok2 = tok;
             while (Token::Match(tok2->next(), "%var% ."))
                 tok2 = tok2->tokAt(2);
-            if (Token::Match(tok2->next(), "%var% ("))
+
+            // indexed statement => skip it unless it mentions the variable
+            const std::unordered_map<const Token *, Statement>::const_iterator stmt = statements.find(tok);
+            if (stmt != statements.end()) {
+                if (!std::binary_search(stmt->second.varids.begin(), stmt->second.varids.end(), varid)) {
+                    tok = stmt->second.last;
+                    continue;
+                }
+            }
+
+            // function calls are interesting..
+            else if (Token::Match(tok2->next(), "%var% ("))
                 ;
 
             else if (Token::Match(tok->next(), "continue|break|return|throw|goto|do|else"))
@@ -798,6 +808,22 @@ Token *CheckMemoryLeakInFunction::getcode(const Token *tok, std::list<const Toke
             }
         } else {
 
+            // indexed if condition that doesn't depend on the variable
+            if (Token::simpleMatch(tok, "if (")) {
+                const std::unordered_map<const Token *, Statement>::const_iterator cond = statements.find(tok);
+                if (cond != statements.end()) {
+                    const std::vector<unsigned int> &varids = cond->second.varids;
+                    bool dep = std::binary_search(varids.begin(), varids.end(), varid);
+                    for (std::size_t i = 0; i < varids.size() && !dep && !extravar.empty(); ++i)
+                        dep = extravar.find(varids[i]) != extravar.end();
+                    if (!dep) {
+                        addtoken(&rettail, tok, "if");
+                        tok = cond->second.last;
+                        continue;
+                    }
+                }
+            }
+
             if (Token::Match(tok, "%varid% = close ( %varid% )", varid)) {
                 addtoken(&rettail, tok, "dealloc");
                 addtoken(&rettail, tok, ";");
@@ -2026,6 +2052,83 @@ const Token *CheckMemoryLeakInFunction::findleak(const Token *tokens)
 
 
 // Check for memory leaks for a function variable.
+bool CheckMemoryLeakInFunction::isSkippableCall(const Token *tok) const
+{
+    if (!Token::Match(tok, "%var% (") || !Token::simpleMatch(tok->linkAt(1), ") ;"))
+        return false;
+
+    // Every call in the statement must be a white listed function that getcode
+    // ignores unless the variable is passed to it
+    const Token * const end = tok->linkAt(1);
+    for (const Token *tok2 = tok; tok2 != end; tok2 = tok2->next()) {
+        if (Token::Match(tok2, "[{}:;]"))
+            return false;
+        if (tok2->str() != "(")
+            continue;
+
+        const Token *ftok = tok2->previous();
+        if (!ftok || !ftok->isName() || !test_white_list_with_lib(ftok->str(), _settings))
+            return false;
+        if (Token::Match(ftok, "asprintf|delete|fclose|for|free|if|realloc|return|switch|while|sizeof|setjmp|longjmp"))
+            return false;
+        if (_settings->library.isnoreturn(ftok->str()) || (ftok->function() && ftok->function()->isAttributeNoreturn()))
+            return false;
+    }
+    return true;
+}
+
+void CheckMemoryLeakInFunction::createStatementIndex()
+{
+    statements.clear();
+
+    const std::size_t functions = symbolDatabase->functionScopes.size();
+    for (std::size_t i = 0; i < functions; ++i) {
+        const Scope * scope = symbolDatabase->functionScopes[i];
+        for (const Token *tok = scope->classStart; tok != scope->classEnd; tok = tok->next()) {
+            if (Token::simpleMatch(tok, "if (")) {
+                Statement cond;
+                for (const Token *tok2 = tok->tokAt(2); tok2 != tok->linkAt(1); tok2 = tok2->next()) {
+                    if (tok2->varId())
+                        cond.varids.push_back(tok2->varId());
+                }
+                std::sort(cond.varids.begin(), cond.varids.end());
+                cond.varids.erase(std::unique(cond.varids.begin(), cond.varids.end()), cond.varids.end());
+                cond.last = tok->linkAt(1);
+                statements[tok] = cond;
+                continue;
+            }
+
+            if (!Token::Match(tok, "[;{}]") || Token::Match(tok->next(), "[{};]"))
+                continue;
+
+            // same classification of the statement as in getcode
+            bool call = false;
+            if (Token::Match(tok->next(), "%var% .|(")) {
+                if (!isSkippableCall(tok->next()))
+                    continue;
+                call = true;
+            } else if (Token::Match(tok->next(), "continue|break|return|throw|goto|do|else"))
+                continue;
+
+            Statement stmt;
+            const Token *tok2;
+            for (tok2 = tok->next(); tok2 && tok2->str() != ";"; tok2 = tok2->next()) {
+                if (!call && Token::Match(tok2, "[:{}]"))
+                    break;
+                if (tok2->varId())
+                    stmt.varids.push_back(tok2->varId());
+            }
+            if (!tok2 || tok2->str() != ";")
+                continue;
+
+            std::sort(stmt.varids.begin(), stmt.varids.end());
+            stmt.varids.erase(std::unique(stmt.varids.begin(), stmt.varids.end()), stmt.varids.end());
+            stmt.last = tok2->previous();
+            statements[tok] = stmt;
+        }
+    }
+}
+
 void CheckMemoryLeakInFunction::checkScope(const Token *Tok1, const std::string &varname, unsigned int varid, bool classmember, unsigned int sz)
 {
     std::list<const Token *> callstack;
@@ -2215,39 +2318,51 @@ static bool isInMemberFunc(const Scope* scope)
 
 void CheckMemoryLeakInFunction::check()
 {
-    // Check locking/unlocking of global resources..
-    const std::size_t functions = symbolDatabase->functionScopes.size();
-    for (std::size_t i = 0; i < functions; ++i) {
-        const Scope * scope = symbolDatabase->functionScopes[i];
+    // The function scopes and variables are checked in parallel with
+    // --check-threads
+    ParallelLoop loop(_errorLogger, _settings);
+    CheckMemoryLeakInFunction checkMemoryLeak(_tokenizer, _settings, &loop);
+    checkMemoryLeak.createStatementIndex();
 
-        checkScope(scope->classStart->next(), "", 0, scope->functionOf != nullptr, 1);
-    }
+    // Check locking/unlocking of global resources..
+    loop.forEach(symbolDatabase->functionScopes.size(), &checkMemoryLeak, &CheckMemoryLeakInFunction::checkFunctionScope);
 
     // Check variables..
-    for (unsigned int i = 1; i < symbolDatabase->getVariableListSize(); i++) {
-        const Variable* var = symbolDatabase->getVariableFromVarId(i);
-        if (!var || (!var->isLocal() && !var->isArgument()) || var->isStatic() || !var->scope())
-            continue;
+    loop.forEach(symbolDatabase->getVariableListSize(), &checkMemoryLeak, &CheckMemoryLeakInFunction::checkVariable);
+}
 
-        if (var->isReference())
-            continue;
+void CheckMemoryLeakInFunction::checkFunctionScope(std::size_t i)
+{
+    const Scope * scope = symbolDatabase->functionScopes[i];
 
-        if (!var->isPointer() && var->typeStartToken()->str() != "int")
-            continue;
+    checkScope(scope->classStart->next(), "", 0, scope->functionOf != nullptr, 1);
+}
 
-        // check for known class without implementation (forward declaration)
-        if (var->isPointer() && var->type() && !var->typeScope())
-            continue;
+void CheckMemoryLeakInFunction::checkVariable(std::size_t i)
+{
+    const Variable* var = symbolDatabase->getVariableFromVarId(i);
+    if (!var || (!var->isLocal() && !var->isArgument()) || var->isStatic() || !var->scope())
+        return;
 
-        unsigned int sz = _tokenizer->sizeOfType(var->typeStartToken());
-        if (sz < 1)
-            sz = 1;
+    if (var->isReference())
+        return;
 
-        if (var->isArgument())
-            checkScope(var->scope()->classStart->next(), var->name(), i, isInMemberFunc(var->scope()), sz);
-        else
-            checkScope(var->nameToken(), var->name(), i, isInMemberFunc(var->scope()), sz);
-    }
+    if (!var->isPointer() && var->typeStartToken()->str() != "int")
+        return;
+
+    // check for known class without implementation (forward declaration)
+    if (var->isPointer() && var->type() && !var->typeScope())
+        return;
+
+    unsigned int sz = _tokenizer->sizeOfType(var->typeStartToken());
+    if (sz < 1)
+        sz = 1;
+
+    const unsigned int varid = static_cast<unsigned int>(i);
+    if (var->isArgument())
+        checkScope(var->scope()->classStart->next(), var->name(), varid, isInMemberFunc(var->scope()), sz);
+    else
+        checkScope(var->nameToken(), var->name(), varid, isInMemberFunc(var->scope()), sz);
 }
 //---------------------------------------------------------------------------
 
@@ -2490,13 +2605,8 @@ bool CheckMemoryLeakStructMember::isMalloc(const Variable *variable)
 void CheckMemoryLeakStructMember::checkStructVariable(const Variable * const variable)
 {
     // This should be in the CheckMemoryLeak base class
-    static std::set<std::string> ignoredFunctions;
-    if (ignoredFunctions.empty()) {
-        ignoredFunctions.insert("if");
-        ignoredFunctions.insert("for");
-        ignoredFunctions.insert("while");
-        ignoredFunctions.insert("malloc");
-    }
+    static const char * const ignoredFunctions_[] = { "if", "for", "while", "malloc" };
+    static const std::set<std::string> ignoredFunctions(ignoredFunctions_, ignoredFunctions_ + sizeof(ignoredFunctions_) / sizeof(*ignoredFunctions_));
 
     // Is struct variable a pointer?
     if (variable->isPointer()) {
@@ -37,6 +37,8 @@
 
 #include <list>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class Scope;
 class Function;
@@ -176,6 +178,9 @@ public:
  * -# create a simple token list that describes the usage of the function variable.
  * -# simplify the token list.
  * -# finally, check if the simplified token list contain any leaks.
+ *
+ * The statements of all function bodies are indexed once, so step 2 can skip
+ * statements that don't mention the variable without scanning them again.
  */
 
 class CPPCHECKLIB CheckMemoryLeakInFunction : private Check, public CheckMemoryLeak {
@@ -208,6 +213,12 @@ public:
     /** @brief Perform checking */
     void check();
 
+    /** @brief Check locking/unlocking of global resources in the i:th function scope */
+    void checkFunctionScope(std::size_t i);
+
+    /** @brief Check the variable with varid i */
+    void checkVariable(std::size_t i);
+
     /**
      * Checking for a memory leak caused by improper realloc usage.
      */
@@ -296,7 +307,25 @@ public:
      */
     void checkScope(const Token *Tok1, const std::string &varname, unsigned int varid, bool classmember, unsigned int sz);
 
+    /**
+     * Index the statements and if conditions of all function bodies. getcode
+     * uses the index to skip code that can't affect the checked variable.
+     */
+    void createStatementIndex();
+
 private:
+    /** A statement or if condition that getcode skips unless it mentions the variable */
+    struct Statement {
+        /** last token before the ";", or the ")" of the if condition */
+        const Token *last;
+
+        /** sorted ids of the variables in the statement */
+        std::vector<unsigned int> varids;
+    };
+
+    /** Check if a function call statement has no effect on variables that are not passed to it */
+    bool isSkippableCall(const Token *tok) const;
+
     /** Report all possible errors (for the --errorlist) */
     void getErrorMessages(ErrorLogger *e, const Settings *settings) const {
         CheckMemoryLeakInFunction c(0, settings, e);
@@ -329,6 +358,9 @@ private:
     }
 
     const SymbolDatabase *symbolDatabase;
+
+    /** Skippable statements keyed by the "[;{}]" in front of them, and if conditions keyed by the "if" */
+    std::unordered_map<const Token *, Statement> statements;
 };
 
 
@@ -31,39 +31,58 @@ namespace {
     CheckNonReentrantFunctions instance;
 }
 
+static const char * const non_reentrant_functions_list[] = {
+    "localtime", "gmtime", "strtok", "gethostbyname", "gethostbyaddr", "getservbyname"
+    , "getservbyport", "crypt", "ttyname", "gethostbyname2"
+    , "getprotobyname", "getnetbyname", "getnetbyaddr", "getrpcbyname", "getrpcbynumber", "getrpcent"
+    , "ctermid", "readdir", "getlogin", "getpwent", "getpwnam", "getpwuid", "getspent"
+    , "fgetspent", "getspnam", "getgrnam", "getgrgid", "getnetgrent", "tempnam", "fgetpwent"
+    , "fgetgrent", "ecvt", "gcvt", "getservent", "gethostent", "getgrent", "fcvt"
+};
+
+const std::set<std::string> &CheckNonReentrantFunctions::nonReentrantFunctionList()
+{
+    static const std::set<std::string> functions(non_reentrant_functions_list,
+            non_reentrant_functions_list + sizeof(non_reentrant_functions_list) / sizeof(*non_reentrant_functions_list));
+    return functions;
+}
+
+std::string CheckNonReentrantFunctions::nonReentrantFunctionMessage(const std::string &name)
+{
+    return "Non reentrant function '" + name + "' called. For threadsafe applications it is recommended to use the reentrant replacement function '" + name + "_r'.";
+}
+
 void CheckNonReentrantFunctions::nonReentrantFunctions()
 {
     if (!_settings->standards.posix || !_settings->isEnabled("portability"))
         return;
 
     const SymbolDatabase * const symbolDatabase = _tokenizer->getSymbolDatabase();
-    const std::size_t functions = symbolDatabase->functionScopes.size();
-    for (std::size_t i = 0; i < functions; ++i) {
-        const Scope * scope = symbolDatabase->functionScopes[i];
-        for (const Token *tok = scope->classStart->next(); tok != scope->classEnd; tok = tok->next()) {
-            // Look for function invocations
-            if (tok->varId() != 0 || !tok->isName() || tok->strAt(1) != "(")
-                continue;
 
-            // Check for non-reentrant function name
-        auto it = _nonReentrantFunctions.find(tok->str());
-            if (it == _nonReentrantFunctions.end())
-                continue;
+    const std::set<std::string> &functions = nonReentrantFunctionList();
+
+    // Look for function invocations
+    const std::vector<const Token *> &calls = symbolDatabase->functionCallTokens();
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        const Token *tok = calls[i];
 
-            const Token *prev = tok->previous();
-            if (prev) {
-                // Ignore function definitions, class members or class definitions
-                if (prev->str() == ".")
-                    continue;
+        // Check for non-reentrant function name
+        if (functions.find(tok->str()) == functions.end())
+            continue;
 
-                // Check for "std" or global namespace, ignore other namespaces
-                if (prev->str() == "::" && prev->previous() && prev->previous()->str() != "std" && prev->previous()->isName())
-                    continue;
-            }
+        const Token *prev = tok->previous();
+        if (prev) {
+            // Ignore function definitions, class members or class definitions
+            if (prev->str() == ".")
+                continue;
 
-            // Only affecting multi threaded code, therefore this is "portability"
-            reportError(tok, Severity::portability, "nonreentrantFunctions" + it->first, it->second);
+            // Check for "std" or global namespace, ignore other namespaces
+            if (prev->str() == "::" && prev->previous() && prev->previous()->str() != "std" && prev->previous()->isName())
+                continue;
         }
+
+        // Only affecting multi threaded code, therefore this is "portability"
+        reportError(tok, Severity::portability, "nonreentrantFunctions" + tok->str(), nonReentrantFunctionMessage(tok->str()));
     }
 }
 //---------------------------------------------------------------------------
@@ -24,7 +24,7 @@
 #include "config.h"
 #include "check.h"
 #include <string>
-#include <map>
+#include <set>
 
 
 /// @addtogroup Checks
@@ -38,13 +38,11 @@ class CPPCHECKLIB CheckNonReentrantFunctions : public Check {
 public:
     /** This constructor is used when registering the CheckNonReentrantFunctions */
     CheckNonReentrantFunctions() : Check(myName()) {
-        initNonReentrantFunctions();
     }
 
     /** This constructor is used when running checks. */
     CheckNonReentrantFunctions(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
         : Check(myName(), tokenizer, settings, errorLogger) {
-        initNonReentrantFunctions();
     }
 
     void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
@@ -52,42 +50,31 @@ public:
         checkNonReentrantFunctions.nonReentrantFunctions();
     }
 
+    unsigned int phases() const {
+        return SIMPLIFIED;
+    }
+
+    unsigned int severities() const {
+        return severityBit(Severity::portability);
+    }
+
     /** Check for non reentrant functions */
     void nonReentrantFunctions();
 
 private:
 
-    /* function name / error message */
-    std::map<std::string,std::string> _nonReentrantFunctions;
-
-    /** init nonreentrant functions list ' */
-    void initNonReentrantFunctions() {
-        static const char * const non_reentrant_functions_list[] = {
-            "localtime", "gmtime", "strtok", "gethostbyname", "gethostbyaddr", "getservbyname"
-            , "getservbyport", "crypt", "ttyname", "gethostbyname2"
-            , "getprotobyname", "getnetbyname", "getnetbyaddr", "getrpcbyname", "getrpcbynumber", "getrpcent"
-            , "ctermid", "readdir", "getlogin", "getpwent", "getpwnam", "getpwuid", "getspent"
-            , "fgetspent", "getspnam", "getgrnam", "getgrgid", "getnetgrent", "tempnam", "fgetpwent"
-            , "fgetgrent", "ecvt", "gcvt", "getservent", "gethostent", "getgrent", "fcvt"
-        };
-
-        // generate messages
-        for (unsigned int i = 0; i < (sizeof(non_reentrant_functions_list) / sizeof(char *)); ++i) {
-            std::string strMsg("Non reentrant function '");
-            strMsg+=non_reentrant_functions_list[i];
-            strMsg+= "' called. For threadsafe applications it is recommended to use the reentrant replacement function '";
-            strMsg+=non_reentrant_functions_list[i];
-            strMsg+="_r'.";
-            _nonReentrantFunctions[non_reentrant_functions_list[i]] = strMsg;
-        }
-    }
+    /** names of the non reentrant functions. The list is shared by all instances. */
+    static const std::set<std::string> &nonReentrantFunctionList();
+
+    /** error message for a non reentrant function */
+    static std::string nonReentrantFunctionMessage(const std::string &name);
 
     void getErrorMessages(ErrorLogger *errorLogger, const Settings *settings) const {
         CheckNonReentrantFunctions c(0, settings, errorLogger);
 
-        auto it(_nonReentrantFunctions.begin()), itend(_nonReentrantFunctions.end());
-        for (; it!=itend; ++it) {
-            c.reportError(0, Severity::portability, "nonreentrantFunctions"+it->first, it->second);
+        const std::set<std::string> &functions = nonReentrantFunctionList();
+        for (auto it = functions.begin(); it != functions.end(); ++it) {
+            c.reportError(0, Severity::portability, "nonreentrantFunctions"+*it, nonReentrantFunctionMessage(*it));
         }
     }
 
@@ -97,9 +84,9 @@ private:
 
     std::string classInfo() const {
         std::string info = "Warn if any of these non reentrant functions are used:\n";
-        auto it(_nonReentrantFunctions.begin()), itend(_nonReentrantFunctions.end());
-        for (; it!=itend; ++it) {
-            info += "- " + it->first + "\n";
+        const std::set<std::string> &functions = nonReentrantFunctionList();
+        for (auto it = functions.begin(); it != functions.end(); ++it) {
+            info += "- " + *it + "\n";
         }
         return info;
     }
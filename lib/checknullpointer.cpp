@@ -51,23 +51,24 @@ void CheckNullPointer::parseFunctionCall(const Token &tok, std::list<const Token
 
     const Token* firstParam = tok.tokAt(2);
     const Token* secondParam = firstParam->nextArgument();
+    const Library::FunctionDescriptor *libfunc = library ? library->descriptor(tok.str()) : nullptr;
 
     // 1st parameter..
     if ((Token::Match(firstParam, "%var% ,|)") && firstParam->varId() > 0) ||
         (value == 0 && Token::Match(firstParam, "0|NULL ,|)"))) {
         if (value == 0 && Token::Match(&tok, "snprintf|vsnprintf|fnprintf|vfnprintf") && secondParam && secondParam->str() != "0") // Only if length (second parameter) is not zero
             var.push_back(firstParam);
-        else if (value == 0 && library != nullptr && library->isnullargbad(tok.str(), 1) && checkNullpointerFunctionCallPlausibility(tok.function(), 1))
+        else if (value == 0 && libfunc && libfunc->isnullargbad(1) && checkNullpointerFunctionCallPlausibility(tok.function(), 1))
             var.push_back(firstParam);
-        else if (value == 1 && library != nullptr && library->isuninitargbad(tok.str(), 1))
+        else if (value == 1 && libfunc && libfunc->isuninitargbad(1))
             var.push_back(firstParam);
     }
 
     // 2nd parameter..
     if ((value == 0 && Token::Match(secondParam, "0|NULL ,|)")) || (secondParam && secondParam->varId() > 0 && Token::Match(secondParam->next(),"[,)]"))) {
-        if (value == 0 && library != nullptr && library->isnullargbad(tok.str(), 2) && checkNullpointerFunctionCallPlausibility(tok.function(), 2))
+        if (value == 0 && libfunc && libfunc->isnullargbad(2) && checkNullpointerFunctionCallPlausibility(tok.function(), 2))
             var.push_back(secondParam);
-        else if (value == 1 && library != nullptr && library->isuninitargbad(tok.str(), 2))
+        else if (value == 1 && libfunc && libfunc->isuninitargbad(2))
             var.push_back(secondParam);
     }
 
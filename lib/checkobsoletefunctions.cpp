@@ -23,6 +23,8 @@
 #include "checkobsoletefunctions.h"
 #include "symboldatabase.h"
 
+#include <set>
+
 //---------------------------------------------------------------------------
 
 
@@ -31,6 +33,115 @@ namespace {
     CheckObsoleteFunctions instance;
 }
 
+// Obsolete posix functions, which messages suggest only one alternative and doesn't contain additional information.
+static const struct {
+    const char* bad;
+    const char* good;
+} posix_stdmsgs[] = {
+    {"bsd_signal", "sigaction"},
+    {"gethostbyaddr", "getnameinfo"},
+    {"gethostbyname", "getaddrinfo"},
+    {"bcmp", "memcmp"},
+    {"bzero", "memset"},
+    {"ecvt", "sprintf"},
+    {"fcvt", "sprintf"},
+    {"gcvt", "sprintf"},
+    {"getwd", "getcwd"},
+    {"index", "strchr"}, // See #2334 (using the Qt Model/View function 'index')
+    {"rindex", "strrchr"},
+    {"pthread_attr_getstackaddr", "pthread_attr_getstack"},
+    {"pthread_attr_setstackaddr", "pthread_attr_setstack"},
+    {"vfork", "fork"},
+    {"wcswcs", "wcsstr"},
+    {"rand_r", "rand"},
+    {"utime", "utimensat"},
+    {"asctime_r", "strftime"},
+    {"ctime_r", "strftime"}
+};
+
+static CheckObsoleteFunctions::ObsoleteFunction replaceWith(const char *good)
+{
+    const CheckObsoleteFunctions::ObsoleteFunction f = { good, nullptr };
+    return f;
+}
+
+static CheckObsoleteFunctions::ObsoleteFunction messageText(const char *text)
+{
+    const CheckObsoleteFunctions::ObsoleteFunction f = { nullptr, text };
+    return f;
+}
+
+static CheckObsoleteFunctions::ObsoleteFunctionMap createStandardFunctions()
+{
+    CheckObsoleteFunctions::ObsoleteFunctionMap functions;
+    functions["gets"] = messageText("Obsolete function 'gets' called. It is recommended to use the function 'fgets' instead.\n"
+                                    "The obsolete function 'gets' is called. With 'gets' you'll get a buffer overrun if the input data exceeds the size of the buffer. It is recommended to use the function 'fgets' instead.");
+    return functions;
+}
+
+const CheckObsoleteFunctions::ObsoleteFunctionMap &CheckObsoleteFunctions::obsoleteStandardFunctions()
+{
+    static const ObsoleteFunctionMap functions(createStandardFunctions());
+    return functions;
+}
+
+static CheckObsoleteFunctions::ObsoleteFunctionMap createPosixFunctions()
+{
+    CheckObsoleteFunctions::ObsoleteFunctionMap functions;
+    for (std::size_t i = 0; i < (sizeof(posix_stdmsgs) / sizeof(*posix_stdmsgs)); ++i)
+        functions[posix_stdmsgs[i].bad] = replaceWith(posix_stdmsgs[i].good);
+
+    functions["usleep"] = messageText("Obsolete function 'usleep' called. It is recommended to use the 'nanosleep' or 'setitimer' function instead.\n"
+                                      "The obsolete function 'usleep' is called. POSIX.1-2001 declares usleep() function obsolete and POSIX.1-2008 removes it. It is recommended that new applications use the 'nanosleep' or 'setitimer' function.");
+
+    functions["bcopy"] = messageText("Obsolete function 'bcopy' called. It is recommended to use the 'memmove' or 'memcpy' function instead.");
+
+    functions["ftime"] = messageText("Obsolete function 'ftime' called. It is recommended to use time(), gettimeofday() or clock_gettime() instead.");
+
+    functions["getcontext"] = messageText("Obsolete function 'getcontext' called. Due to portability issues, applications are recommended to be rewritten to use POSIX threads.");
+    functions["makecontext"] = messageText("Obsolete function 'makecontext' called. Due to portability issues, applications are recommended to be rewritten to use POSIX threads.");
+    functions["swapcontext"] = messageText("Obsolete function 'swapcontext' called. Due to portability issues, applications are recommended to be rewritten to use POSIX threads.");
+
+    functions["scalbln"] = messageText("Obsolete function 'scalb' called. It is recommended to use 'scalbln', 'scalblnf' or 'scalblnl' instead.");
+
+    functions["ualarm"] = messageText("Obsolete function 'ualarm' called. It is recommended to use 'timer_create', 'timer_delete', 'timer_getoverrun', 'timer_gettime' or 'timer_settime' instead.");
+
+    functions["tmpnam"] = messageText("Obsolete function 'tmpnam' called. It is recommended to use 'tmpfile', 'mkstemp' or 'mkdtemp' instead.");
+
+    functions["tmpnam_r"] = messageText("Obsolete function 'tmpnam_r' called. It is recommended to use 'tmpfile', 'mkstemp' or 'mkdtemp' instead.");
+    return functions;
+}
+
+const CheckObsoleteFunctions::ObsoleteFunctionMap &CheckObsoleteFunctions::obsoletePosixFunctions()
+{
+    static const ObsoleteFunctionMap functions(createPosixFunctions());
+    return functions;
+}
+
+static CheckObsoleteFunctions::ObsoleteFunctionMap createC99Functions()
+{
+    CheckObsoleteFunctions::ObsoleteFunctionMap functions;
+    functions["alloca"] = messageText("Obsolete function 'alloca' called. In C99 and later it is recommended to use a variable length array instead.\n"
+                                      "The obsolete function 'alloca' is called. In C99 and later it is recommended to use a variable length array or a dynamically allocated array instead. The function 'alloca' is dangerous for many reasons (http://stackoverflow.com/questions/1018853/why-is-alloca-not-considered-good-practice and http://linux.die.net/man/3/alloca).");
+    functions["asctime"] = messageText("Obsolete function 'asctime' called. It is recommended to use the function 'strftime' instead.");
+    // ctime is obsolete - it's not threadsafe. but there is no good replacement.
+    //functions["ctime"] = messageText("Obsolete function 'ctime' called. It is recommended to use the function 'strftime' instead.");
+    return functions;
+}
+
+const CheckObsoleteFunctions::ObsoleteFunctionMap &CheckObsoleteFunctions::obsoleteC99Functions()
+{
+    static const ObsoleteFunctionMap functions(createC99Functions());
+    return functions;
+}
+
+std::string CheckObsoleteFunctions::obsoleteFunctionMessage(const ObsoleteFunctionMap::const_iterator &it)
+{
+    if (it->second.text)
+        return it->second.text;
+    return "Obsolete function '" + it->first + "' called. It is recommended to use the function '" + it->second.replacement + "' instead.";
+}
+
 void CheckObsoleteFunctions::obsoleteFunctions()
 {
     if (!_settings->isEnabled("style"))
@@ -39,37 +150,38 @@ void CheckObsoleteFunctions::obsoleteFunctions()
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
 
     // Functions defined somewhere?
-    for (unsigned int i = 0; i < symbolDatabase->functionScopes.size(); i++) {
-        const Scope* scope = symbolDatabase->functionScopes[i];
-        _obsoleteStandardFunctions.erase(scope->className);
-        _obsoletePosixFunctions.erase(scope->className);
-        _obsoleteC99Functions.erase(scope->className);
-    }
+    std::set<std::string> definedFunctions;
+    for (unsigned int i = 0; i < symbolDatabase->functionScopes.size(); i++)
+        definedFunctions.insert(symbolDatabase->functionScopes[i]->className);
+
+    const ObsoleteFunctionMap &standardFunctions = obsoleteStandardFunctions();
+    const ObsoleteFunctionMap &posixFunctions = obsoletePosixFunctions();
+    const ObsoleteFunctionMap &c99Functions = obsoleteC99Functions();
 
-    for (unsigned int i = 0; i < symbolDatabase->functionScopes.size(); i++) {
-        const Scope* scope = symbolDatabase->functionScopes[i];
-        for (const Token* tok = scope->classStart; tok != scope->classEnd; tok = tok->next()) {
-            if (tok->isName() && tok->varId()==Token::eVariable && (tok->next() && tok->next()->str() == "(") &&
-                (!Token::Match(tok->previous(), ".|::") || Token::simpleMatch(tok->tokAt(-2), "std ::"))) {
-
-                auto it = _obsoleteStandardFunctions.find(tok->str());
-                if (it != _obsoleteStandardFunctions.end()) {
-                    // If checking an old code base it might be uninteresting to update obsolete functions.
-                    reportError(tok, Severity::style, "obsoleteFunctions"+it->first, it->second);
-                } else {
-                    if (_settings->standards.posix) {
-                        it = _obsoletePosixFunctions.find(tok->str());
-                        if (it != _obsoletePosixFunctions.end()) {
-                            // If checking an old code base it might be uninteresting to update obsolete functions.
-                            reportError(tok, Severity::style, "obsoleteFunctions"+it->first, it->second);
-                        }
+    const std::vector<const Token *> &calls = symbolDatabase->functionCallTokens();
+    for (std::size_t i = 0; i < calls.size(); i++) {
+        const Token *tok = calls[i];
+        if (definedFunctions.find(tok->str()) != definedFunctions.end())
+            continue;
+        if (!Token::Match(tok->previous(), ".|::") || Token::simpleMatch(tok->tokAt(-2), "std ::")) {
+
+            auto it = standardFunctions.find(tok->str());
+            if (it != standardFunctions.end()) {
+                // If checking an old code base it might be uninteresting to update obsolete functions.
+                reportError(tok, Severity::style, "obsoleteFunctions"+it->first, obsoleteFunctionMessage(it));
+            } else {
+                if (_settings->standards.posix) {
+                    it = posixFunctions.find(tok->str());
+                    if (it != posixFunctions.end()) {
+                        // If checking an old code base it might be uninteresting to update obsolete functions.
+                        reportError(tok, Severity::style, "obsoleteFunctions"+it->first, obsoleteFunctionMessage(it));
                     }
-                    if (_settings->standards.c >= Standards::C99) {
-                        // alloca : this function is obsolete in C but not in C++ (#4382)
-                        it = _obsoleteC99Functions.find(tok->str());
-                        if (it != _obsoleteC99Functions.end() && !(tok->str() == "alloca" && _tokenizer->isCPP())) {
-                            reportError(tok, Severity::style, "obsoleteFunctions"+it->first, it->second);
-                        }
+                }
+                if (_settings->standards.c >= Standards::C99) {
+                    // alloca : this function is obsolete in C but not in C++ (#4382)
+                    it = c99Functions.find(tok->str());
+                    if (it != c99Functions.end() && !(tok->str() == "alloca" && _tokenizer->isCPP())) {
+                        reportError(tok, Severity::style, "obsoleteFunctions"+it->first, obsoleteFunctionMessage(it));
                     }
                 }
             }
@@ -32,6 +32,32 @@ namespace {
 	CheckOther instance;
 }
 
+void CheckOther::subscribe(TokenDispatcher &dispatcher, Phase phase, const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
+{
+    CheckOther * const checkOther = dispatcher.addCheck(new CheckOther(tokenizer, settings, errorLogger));
+
+    if (phase == NORMAL) {
+        dispatcher.subscribe("inf.0", checkOther, &CheckOther::checkNanInArithmeticExpression, "checkNanInArithmeticExpression");
+        dispatcher.subscribe("+", checkOther, &CheckOther::checkNanInArithmeticExpression, "checkNanInArithmeticExpression");
+        dispatcher.subscribe("-", checkOther, &CheckOther::checkNanInArithmeticExpression, "checkNanInArithmeticExpression");
+        return;
+    }
+
+    if (settings->isEnabled("style"))
+        dispatcher.subscribe("?", checkOther, &CheckOther::clarifyCalculation, "clarifyCalculation", TokenDispatcher::FUNCTION_BODIES);
+    if (settings->isEnabled("warning"))
+        dispatcher.subscribe("*", checkOther, &CheckOther::clarifyStatement, "clarifyStatement", TokenDispatcher::FUNCTION_BODIES);
+
+    static const char * const divisions[] = { "/", "%", "div", "ldiv", "lldiv", "imaxdiv" };
+    for (std::size_t i = 0; i < sizeof(divisions) / sizeof(*divisions); ++i)
+        dispatcher.subscribe(divisions[i], checkOther, &CheckOther::checkZeroDivision, "checkZeroDivision");
+
+    if (settings->isEnabled("warning"))
+        dispatcher.subscribe("memset", checkOther, &CheckOther::checkMemsetZeroBytes, "checkMemsetZeroBytes", TokenDispatcher::FUNCTION_BODIES);
+    if (settings->isEnabled("warning") || settings->isEnabled("portability"))
+        dispatcher.subscribe("memset", checkOther, &CheckOther::checkMemsetInvalid2ndParam, "checkMemsetInvalid2ndParam", TokenDispatcher::FUNCTION_BODIES);
+}
+
 bool astIsFloat(const Token *tok, bool unknown)
 {
     if (tok->astOperand2() && (tok->str() == "." || tok->str() == "::"))
@@ -59,10 +85,9 @@ bool astIsFloat(const Token *tok, bool unknown)
 	return unknown;
 }
 
-static bool isConstExpression(const Token *tok, const std::set<std::string> &constFunctions)
+// Is the token itself free from side effects? The operands are not checked.
+static bool isConstToken(const Token *tok, const std::set<std::string> &constFunctions)
 {
-	if (!tok)
-		return true;
 	if (tok->isName() && tok->next()->str() == "(") {
 		if (!tok->function() && !Token::Match(tok->previous(), ".|::") && constFunctions.find(tok->str()) == constFunctions.end())
 			return false;
@@ -74,7 +99,7 @@ static bool isConstExpression(const Token *tok, const std::set<std::string> &con
 	// bailout when we see ({..})
 	if (tok->str() == "{")
 		return false;
-	return isConstExpression(tok->astOperand1(),constFunctions) && isConstExpression(tok->astOperand2(),constFunctions);
+	return true;
 }
 
 bool isSameExpression(const Token *tok1, const Token *tok2, const std::set<std::string> &constFunctions)
@@ -155,6 +180,54 @@ bool isSameExpression(const Token *tok1, const Token *tok2, const std::set<std::
 	return commuative_equals;
 }
 
+static std::size_t hashCombine(std::size_t seed, std::size_t value)
+{
+    return seed ^ (value + 0x9e3779b9U + (seed << 6) + (seed >> 2));
+}
+
+const ExpressionHashes::Entry &ExpressionHashes::entry(const Token *tok)
+{
+    const std::unordered_map<const Token *, Entry>::const_iterator it = _entries.find(tok);
+    if (it != _entries.end())
+        return it->second;
+
+    const Token *op1 = tok->astOperand1();
+    const Token *op2 = tok->astOperand2();
+
+    Entry e;
+    e.isConst = isConstToken(tok, _constFunctions) && isConstExpression(op1) && isConstExpression(op2);
+
+    // 'this->x' is the same expression as 'x'
+    if (tok->str() == "." && op1 && op1->str() == "this") {
+        e.hash = hash(op2);
+    } else {
+        e.hash = hashCombine(std::hash<std::string>()(tok->str()), tok->varId());
+
+        // operands of commutative operators can be swapped, see isSameExpression()
+        if (op1 && op2 && Token::Match(tok, "%or%|%oror%|+|*|&|&&|^|==|!="))
+            e.hash = hashCombine(e.hash, hash(op1) + hash(op2));
+        else
+            e.hash = hashCombine(hashCombine(e.hash, hash(op1)), hash(op2));
+    }
+
+    return _entries[tok] = e;
+}
+
+std::size_t ExpressionHashes::hash(const Token *tok)
+{
+    return tok ? entry(tok).hash : 0U;
+}
+
+bool ExpressionHashes::isConstExpression(const Token *tok)
+{
+    return !tok || entry(tok).isConst;
+}
+
+bool ExpressionHashes::isSameExpression(const Token *tok1, const Token *tok2)
+{
+    return hash(tok1) == hash(tok2) && ::isSameExpression(tok1, tok2, _constFunctions);
+}
+
 //----------------------------------------------------------------------------------
 // The return value of fgetc(), getc(), ungetc(), getchar() etc. is an integer value.
 // If this return value is stored in a character variable and then compared
@@ -234,35 +307,25 @@ void CheckOther::checkCastIntToCharAndBackError(const Token *tok, const std::str
 //---------------------------------------------------------------------------
 // Clarify calculation precedence for ternary operators.
 //---------------------------------------------------------------------------
-void CheckOther::clarifyCalculation()
+void CheckOther::clarifyCalculation(const Token *tok)
 {
-	if (!_settings->isEnabled("style"))
+	// ? operator where lhs is arithmetical expression
+	if (!tok->astOperand1() || !tok->astOperand1()->isCalculation())
+		return;
+	if (!tok->astOperand1()->isArithmeticalOp() && tok->astOperand1()->type() != Token::eBitOp)
 		return;
 
-	const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
-	const std::size_t functions = symbolDatabase->functionScopes.size();
-	for (std::size_t i = 0; i < functions; ++i) {
-		const Scope * scope = symbolDatabase->functionScopes[i];
-		for (const Token* tok = scope->classStart->next(); tok != scope->classEnd; tok = tok->next()) {
-			// ? operator where lhs is arithmetical expression
-            if (tok->str() != "?" || !tok->astOperand1() || !tok->astOperand1()->isCalculation())
-                continue;
-            if (!tok->astOperand1()->isArithmeticalOp() && tok->astOperand1()->type() != Token::eBitOp)
-                continue;
-
-			// Is code clarified by parentheses already?
-			const Token *tok2 = tok->astOperand1();
-			for (; tok2; tok2 = tok2->next()) {
-				if (tok2->str() == "(")
-					tok2 = tok2->link();
-				else if (tok2->str() == ")" || tok2->str() == "?")
-					break;
-			}
-
-			if (tok2 && tok2->str() == "?")
-				clarifyCalculationError(tok, tok->astOperand1()->str());
-		}
+	// Is code clarified by parentheses already?
+	const Token *tok2 = tok->astOperand1();
+	for (; tok2; tok2 = tok2->next()) {
+		if (tok2->str() == "(")
+			tok2 = tok2->link();
+		else if (tok2->str() == ")" || tok2->str() == "?")
+			break;
 	}
+
+	if (tok2 && tok2->str() == "?")
+		clarifyCalculationError(tok, tok->astOperand1()->str());
 }
 
 void CheckOther::clarifyCalculationError(const Token *tok, const std::string &op)
@@ -287,28 +350,18 @@ void CheckOther::clarifyCalculationError(const Token *tok, const std::string &op
 //---------------------------------------------------------------------------
 // Clarify (meaningless) statements like *foo++; with parentheses.
 //---------------------------------------------------------------------------
-void CheckOther::clarifyStatement()
+void CheckOther::clarifyStatement(const Token *tok)
 {
-	if (!_settings->isEnabled("warning"))
-		return;
+	if (Token::Match(tok, "* %var%") && tok->astOperand1()) {
+		const Token *tok2=tok->previous();
 
-	const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
-	const std::size_t functions = symbolDatabase->functionScopes.size();
-	for (std::size_t i = 0; i < functions; ++i) {
-		const Scope * scope = symbolDatabase->functionScopes[i];
-		for (const Token* tok = scope->classStart; tok && tok != scope->classEnd; tok = tok->next()) {
-			if (Token::Match(tok, "* %var%") && tok->astOperand1()) {
-				const Token *tok2=tok->previous();
-
-				while (tok2 && tok2->str() == "*")
-					tok2 = tok2->previous();
+		while (tok2 && tok2->str() == "*")
+			tok2 = tok2->previous();
 
-				if (Token::Match(tok2, "[{};]")) {
-					tok2 = tok->astOperand1();
-					if (Token::Match(tok2, "++|-- [;,]"))
-						clarifyStatementError(tok2);
-				}
-			}
+		if (Token::Match(tok2, "[{};]")) {
+			tok2 = tok->astOperand1();
+			if (Token::Match(tok2, "++|-- [;,]"))
+				clarifyStatementError(tok2);
 		}
 	}
 }
@@ -1068,27 +1121,30 @@ void CheckOther::invalidFunctionUsage()
 		for (const Token* tok = scope->classStart->next(); tok != scope->classEnd; tok = tok->next()) {
 			if (!Token::Match(tok, "%var% ( !!)"))
 				continue;
+			const Library::FunctionDescriptor *libfunc = _settings->library.descriptor(tok->str());
+			if (!libfunc)
+				continue;
 			const std::string& functionName = tok->str();
 			int argnr = 1;
 			const Token *argtok = tok->tokAt(2);
 			while (argtok && argtok->str() != ")") {
 				if (Token::Match(argtok,"%num% [,)]")) {
 					if (MathLib::isInt(argtok->str()) &&
-						!_settings->library.isargvalid(functionName, argnr, MathLib::toLongNumber(argtok->str())))
-						invalidFunctionArgError(argtok,functionName,argnr,_settings->library.validarg(functionName,argnr));
+						!libfunc->isargvalid(argnr, MathLib::toLongNumber(argtok->str())))
+						invalidFunctionArgError(argtok,functionName,argnr,libfunc->validarg(argnr));
 				} else {
 					const Token *top = argtok;
 					while (top->astParent() && top->astParent()->str() != "," && top->astParent() != tok->next())
 						top = top->astParent();
 					if (top->isComparisonOp() || Token::Match(top, "%oror%|&&")) {
-						if (_settings->library.isboolargbad(functionName, argnr))
+						if (libfunc->isboolargbad(argnr))
 							invalidFunctionArgBoolError(top, functionName, argnr);
 
 						// Are the values 0 and 1 valid?
-						else if (!_settings->library.isargvalid(functionName, argnr, 0))
-							invalidFunctionArgError(top, functionName, argnr, _settings->library.validarg(functionName,argnr));
-						else if (!_settings->library.isargvalid(functionName, argnr, 1))
-							invalidFunctionArgError(top, functionName, argnr, _settings->library.validarg(functionName,argnr));
+						else if (!libfunc->isargvalid(argnr, 0))
+							invalidFunctionArgError(top, functionName, argnr, libfunc->validarg(argnr));
+						else if (!libfunc->isargvalid(argnr, 1))
+							invalidFunctionArgError(top, functionName, argnr, libfunc->validarg(argnr));
 					}
 				}
 				argnr++;
@@ -1238,22 +1294,12 @@ void CheckOther::unreachableCodeError(const Token *tok, bool inconclusive)
 //---------------------------------------------------------------------------
 // memset(p, y, 0 /* bytes to fill */) <- 2nd and 3rd arguments inverted
 //---------------------------------------------------------------------------
-void CheckOther::checkMemsetZeroBytes()
+void CheckOther::checkMemsetZeroBytes(const Token *tok)
 {
-	if (!_settings->isEnabled("warning"))
-		return;
-
-	const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
-	const std::size_t functions = symbolDatabase->functionScopes.size();
-	for (std::size_t i = 0; i < functions; ++i) {
-		const Scope * scope = symbolDatabase->functionScopes[i];
-		for (const Token* tok = scope->classStart->next(); tok != scope->classEnd; tok = tok->next()) {
-			if (Token::simpleMatch(tok, "memset (")) {
-				const Token* lastParamTok = tok->next()->link()->previous();
-				if (lastParamTok->str() == "0")
-					memsetZeroBytesError(tok, tok->strAt(2));
-			}
-		}
+	if (Token::simpleMatch(tok, "memset (")) {
+		const Token* lastParamTok = tok->next()->link()->previous();
+		if (lastParamTok->str() == "0")
+			memsetZeroBytesError(tok, tok->strAt(2));
 	}
 }
 
@@ -1266,44 +1312,33 @@ void CheckOther::memsetZeroBytesError(const Token *tok, const std::string &varna
 	reportError(tok, Severity::warning, "memsetZeroBytes", summary + "\n" + verbose);
 }
 
-void CheckOther::checkMemsetInvalid2ndParam()
+void CheckOther::checkMemsetInvalid2ndParam(const Token *tok)
 {
-	const bool portability = _settings->isEnabled("portability");
-	const bool warning = _settings->isEnabled("warning");
-	if (!warning && !portability)
+	if (!Token::simpleMatch(tok, "memset ("))
 		return;
 
-	const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
-	const std::size_t functions = symbolDatabase->functionScopes.size();
-	for (std::size_t i = 0; i < functions; ++i) {
-		const Scope * scope = symbolDatabase->functionScopes[i];
-		for (const Token* tok = scope->classStart->next(); tok && (tok != scope->classEnd); tok = tok->next()) {
-			if (Token::simpleMatch(tok, "memset (")) {
-				const Token* firstParamTok = tok->tokAt(2);
-				if (!firstParamTok)
-					continue;
-				const Token* secondParamTok = firstParamTok->nextArgument();
-				if (!secondParamTok)
-					continue;
+	const Token* firstParamTok = tok->tokAt(2);
+	if (!firstParamTok)
+		return;
+	const Token* secondParamTok = firstParamTok->nextArgument();
+	if (!secondParamTok)
+		return;
 
-				// Second parameter is zero literal, i.e. 0.0f
-				if (Token::Match(secondParamTok, "%num% ,") && MathLib::isNullValue(secondParamTok->str()))
-					continue;
+	// Second parameter is zero literal, i.e. 0.0f
+	if (Token::Match(secondParamTok, "%num% ,") && MathLib::isNullValue(secondParamTok->str()))
+		return;
 
-				const Token *top = secondParamTok;
-				while (top->astParent() && top->astParent()->str() != ",")
-					top = top->astParent();
-
-				// Check if second parameter is a float variable or a float literal != 0.0f
-				if (portability && astIsFloat(top,false)) {
-					memsetFloatError(secondParamTok, top->expressionString());
-				} else if (warning && secondParamTok->isNumber()) { // Check if the second parameter is a literal and is out of range
-					const long long int value = MathLib::toLongNumber(secondParamTok->str());
-					if (value < -128 || value > 255)
-						memsetValueOutOfRangeError(secondParamTok, secondParamTok->str());
-				}
-			}
-		}
+	const Token *top = secondParamTok;
+	while (top->astParent() && top->astParent()->str() != ",")
+		top = top->astParent();
+
+	// Check if second parameter is a float variable or a float literal != 0.0f
+	if (_settings->isEnabled("portability") && astIsFloat(top,false)) {
+		memsetFloatError(secondParamTok, top->expressionString());
+	} else if (secondParamTok->isNumber() && _settings->isEnabled("warning")) { // Check if the second parameter is a literal and is out of range
+		const long long int value = MathLib::toLongNumber(secondParamTok->str());
+		if (value < -128 || value > 255)
+			memsetValueOutOfRangeError(secondParamTok, secondParamTok->str());
 	}
 }
 
@@ -1775,30 +1810,28 @@ void CheckOther::constStatementError(const Token *tok, const std::string &type)
 //---------------------------------------------------------------------------
 // Detect division by zero.
 //---------------------------------------------------------------------------
-void CheckOther::checkZeroDivision()
-{
-    for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
-        if (Token::Match(tok, "div|ldiv|lldiv|imaxdiv ( %num% , %num% )") &&
-            MathLib::isInt(tok->strAt(4)) &&
-            MathLib::toLongNumber(tok->strAt(4)) == 0L) {
-            if (tok->str() == "div") {
-                if (tok->strAt(-1) == ".")
-                    continue;
-                if (tok->variable() || tok->function())
-                    continue;
-            }
-            zerodivError(tok,false);
-        } else if (Token::Match(tok, "[/%]") && tok->astOperand2()) {
-            // Value flow..
-            const ValueFlow::Value *value = tok->astOperand2()->getValue(0LL);
-            if (value) {
-                if (!_settings->inconclusive && value->inconclusive)
-                    continue;
-                if (value->condition == nullptr)
-                    zerodivError(tok, value->inconclusive);
-                else if (_settings->isEnabled("warning"))
-                    zerodivcondError(value->condition,tok,value->inconclusive);
-            }
+void CheckOther::checkZeroDivision(const Token *tok)
+{
+    if (Token::Match(tok, "div|ldiv|lldiv|imaxdiv ( %num% , %num% )") &&
+        MathLib::isInt(tok->strAt(4)) &&
+        MathLib::toLongNumber(tok->strAt(4)) == 0L) {
+        if (tok->str() == "div") {
+            if (tok->strAt(-1) == ".")
+                return;
+            if (tok->variable() || tok->function())
+                return;
+        }
+        zerodivError(tok,false);
+    } else if (Token::Match(tok, "[/%]") && tok->astOperand2()) {
+        // Value flow..
+        const ValueFlow::Value *value = tok->astOperand2()->getValue(0LL);
+        if (value) {
+            if (!_settings->inconclusive && value->inconclusive)
+                return;
+            if (value->condition == nullptr)
+                zerodivError(tok, value->inconclusive);
+            else if (_settings->isEnabled("warning"))
+                zerodivcondError(value->condition,tok,value->inconclusive);
         }
     }
 }
@@ -1839,14 +1872,12 @@ void CheckOther::zerodivcondError(const Token *tokcond, const Token *tokdiv, boo
 // double d = 1.0 / 0.0 + 100.0;
 //---------------------------------------------------------------------------
 
-void CheckOther::checkNanInArithmeticExpression()
+void CheckOther::checkNanInArithmeticExpression(const Token *tok)
 {
-    for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
-        if (Token::Match(tok, "inf.0 +|-") ||
-            Token::Match(tok, "+|- inf.0") ||
-            Token::Match(tok, "+|- %num% / 0.0")) {
-            nanInArithmeticExpressionError(tok);
-        }
+    if (Token::Match(tok, "inf.0 +|-") ||
+        Token::Match(tok, "+|- inf.0") ||
+        Token::Match(tok, "+|- %num% / 0.0")) {
+        nanInArithmeticExpressionError(tok);
     }
 }
 
@@ -1986,6 +2017,19 @@ void CheckOther::misusedScopeObjectError(const Token *tok, const std::string& va
 // check for duplicate code in if and else branches
 // if (a) { b = true; } else { b = true; }
 //-----------------------------------------------------------------------------
+// Are the token lists the same, as printed by stringifyList()? Compared token by token so no strings are built.
+static bool isSameCode(const Token *tok1, const Token *end1, const Token *tok2, const Token *end2)
+{
+	for (; tok1 != end1 && tok2 != end2; tok1 = tok1->next(), tok2 = tok2->next()) {
+		if (tok1->str() != tok2->str() ||
+			tok1->isUnsigned() != tok2->isUnsigned() ||
+			(!tok1->isUnsigned() && tok1->isSigned() != tok2->isSigned()) ||
+			tok1->isLong() != tok2->isLong())
+			return false;
+	}
+	return tok1 == end1 && tok2 == end2;
+}
+
 void CheckOther::checkDuplicateBranch()
 {
 	// This is inconclusive since in practice most warnings are noise:
@@ -2019,17 +2063,12 @@ void CheckOther::checkDuplicateBranch()
 			if (macro)
 				continue;
 
-			// save if branch code
-			std::string branch1 = scope->classStart->next()->stringifyList(scope->classEnd);
-
-            if (branch1.empty())
-                continue;
-
-			// save else branch code
-			std::string branch2 = scope->classEnd->tokAt(3)->stringifyList(scope->classEnd->linkAt(2));
+			// empty if branch
+			if (scope->classStart->next() == scope->classEnd)
+				continue;
 
 			// check for duplicates
-            if (branch1 == branch2)
+			if (isSameCode(scope->classStart->next(), scope->classEnd, scope->classEnd->tokAt(3), scope->classEnd->linkAt(2)))
 				duplicateBranchError(scope->classDef, scope->classEnd->next());
 		}
 	}
@@ -2299,6 +2338,8 @@ void CheckOther::checkDuplicateExpression()
 	std::list<const Function*> constFunctions;
 	getConstFunctions(symbolDatabase, constFunctions);
 
+	ExpressionHashes expressions(_settings->library.functionpure);
+
 	for (auto scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
         // only check functions
         if (scope->type != Scope::eFunction)
@@ -2308,7 +2349,7 @@ void CheckOther::checkDuplicateExpression()
             if (tok->isOp() && tok->astOperand1() && !Token::Match(tok, "+|*|<<|>>")) {
                 if (Token::Match(tok, "==|!=|-") && astIsFloat(tok->astOperand1(), true))
                     continue;
-                if (isSameExpression(tok->astOperand1(), tok->astOperand2(), _settings->library.functionpure)) {
+                if (expressions.isSameExpression(tok->astOperand1(), tok->astOperand2())) {
                     if (isWithoutSideEffects(_tokenizer, tok->astOperand1())) {
                         const bool assignment = tok->str() == "=";
                         if (assignment)
@@ -2327,18 +2368,18 @@ void CheckOther::checkDuplicateExpression()
                         }
                     }
                 } else if (!Token::Match(tok, "[-/%]")) { // These operators are not associative
-                    if (tok->astOperand2() && tok->str() == tok->astOperand1()->str() && isSameExpression(tok->astOperand2(), tok->astOperand1()->astOperand2(), _settings->library.functionpure) && isWithoutSideEffects(_tokenizer, tok->astOperand2()))
+                    if (tok->astOperand2() && tok->str() == tok->astOperand1()->str() && expressions.isSameExpression(tok->astOperand2(), tok->astOperand1()->astOperand2()) && isWithoutSideEffects(_tokenizer, tok->astOperand2()))
                         duplicateExpressionError(tok->astOperand2(), tok->astOperand2(), tok->str());
                     else if (tok->astOperand2()) {
                         const Token *ast1 = tok->astOperand1();
                         while (ast1 && tok->str() == ast1->str()) {
-                            if (isSameExpression(ast1->astOperand1(), tok->astOperand2(), _settings->library.functionpure) && isWithoutSideEffects(_tokenizer, ast1->astOperand1()))
+                            if (expressions.isSameExpression(ast1->astOperand1(), tok->astOperand2()) && isWithoutSideEffects(_tokenizer, ast1->astOperand1()))
                                 // TODO: warn if variables are unchanged. See #5683
                                 // Probably the message should be changed to 'duplicate expressions X in condition or something like that'.
                                 ;//duplicateExpressionError(ast1->astOperand1(), tok->astOperand2(), tok->str());
-                            else if (isSameExpression(ast1->astOperand2(), tok->astOperand2(), _settings->library.functionpure) && isWithoutSideEffects(_tokenizer, ast1->astOperand2()))
+                            else if (expressions.isSameExpression(ast1->astOperand2(), tok->astOperand2()) && isWithoutSideEffects(_tokenizer, ast1->astOperand2()))
                                 duplicateExpressionError(ast1->astOperand2(), tok->astOperand2(), tok->str());
-                            if (!isConstExpression(ast1->astOperand2(), _settings->library.functionpure))
+                            if (!expressions.isConstExpression(ast1->astOperand2()))
                                 break;
                             ast1 = ast1->astOperand1();
                         }
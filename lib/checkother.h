@@ -25,12 +25,45 @@
 #include "config.h"
 #include "check.h"
 
+#include <unordered_map>
+
 class Function;
 class Variable;
 
 /** Is expressions same? */
 bool isSameExpression(const Token *tok1, const Token *tok2, const std::set<std::string> &constFunctions);
 
+/**
+ * Structural hashes of AST subtrees, computed once per subtree. Expressions
+ * that isSameExpression() considers the same get the same hash, so only
+ * expressions with equal hashes need to be compared.
+ */
+class CPPCHECKLIB ExpressionHashes {
+public:
+    explicit ExpressionHashes(const std::set<std::string> &constFunctions) : _constFunctions(constFunctions) {
+    }
+
+    /** Structural hash of the expression */
+    std::size_t hash(const Token *tok);
+
+    /** Is the expression free from side effects (no ++/-- and no non-const function calls)? */
+    bool isConstExpression(const Token *tok);
+
+    /** Is expressions same? The hashes are compared first */
+    bool isSameExpression(const Token *tok1, const Token *tok2);
+
+private:
+    struct Entry {
+        std::size_t hash;
+        bool isConst;
+    };
+
+    const Entry &entry(const Token *tok);
+
+    const std::set<std::string> &_constFunctions;
+    std::unordered_map<const Token *, Entry> _entries;
+};
+
 /** Is expression of floating point type? */
 bool astIsFloat(const Token *tok, bool unknown);
 
@@ -71,7 +104,6 @@ public:
         checkOther.checkSignOfUnsignedVariable();  // don't ignore casts (#3574)
         checkOther.checkIncompleteArrayFill();
         checkOther.checkVarFuncNullUB();
-        checkOther.checkNanInArithmeticExpression();
         checkOther.checkCommaSeparatedReturn();
         checkOther.checkIgnoredReturnValue();
     }
@@ -81,20 +113,15 @@ public:
         CheckOther checkOther(tokenizer, settings, errorLogger);
 
         // Checks
-        checkOther.clarifyCalculation();
-        checkOther.clarifyStatement();
         checkOther.checkConstantFunctionParameter();
         checkOther.checkIncompleteStatement();
         checkOther.checkCastIntToCharAndBack();
 
         checkOther.invalidFunctionUsage();
-        checkOther.checkZeroDivision();
         checkOther.checkMathFunctions();
 
         checkOther.redundantGetAndSetUserId();
         checkOther.checkMisusedScopedObject();
-        checkOther.checkMemsetZeroBytes();
-        checkOther.checkMemsetInvalid2ndParam();
         checkOther.checkSwitchCaseFallThrough();
         checkOther.checkPipeParameterSize();
 
@@ -106,11 +133,14 @@ public:
         checkOther.checkComparisonFunctionIsAlwaysTrueOrFalse();
     }
 
-    /** @brief Clarify calculation for ".. a * b ? .." */
-    void clarifyCalculation();
+    /** @brief Subscribe the token handlers of the checks */
+    void subscribe(TokenDispatcher &dispatcher, Phase phase, const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger);
+
+    /** @brief Clarify calculation for ".. a * b ? .." (handler for '?') */
+    void clarifyCalculation(const Token *tok);
 
-    /** @brief Suspicious statement like '*A++;' */
-    void clarifyStatement();
+    /** @brief Suspicious statement like '*A++;' (handler for '*') */
+    void clarifyStatement(const Token *tok);
 
     /** @brief Are there C-style pointer casts in a c++ file? */
     void warningOldStylePointerCast();
@@ -144,14 +174,14 @@ public:
     /** @brief Incomplete statement. A statement that only contains a constant or variable */
     void checkIncompleteStatement();
 
-    /** @brief %Check zero division*/
-    void checkZeroDivision();
+    /** @brief %Check zero division (handler for '/', '%' and the div() functions) */
+    void checkZeroDivision(const Token *tok);
 
     /** @brief %Check zero division / useless condition */
     void checkZeroDivisionOrUselessCondition();
 
-    /** @brief Check for NaN (not-a-number) in an arithmetic expression */
-    void checkNanInArithmeticExpression();
+    /** @brief Check for NaN (not-a-number) in an arithmetic expression (handler for '+', '-' and 'inf.0') */
+    void checkNanInArithmeticExpression(const Token *tok);
 
     /** @brief %Check for parameters given to math function that do not make sense*/
     void checkMathFunctions();
@@ -177,11 +207,11 @@ public:
     /** @brief %Check for objects that are destroyed immediately */
     void checkMisusedScopedObject();
 
-    /** @brief %Check for filling zero bytes with memset() */
-    void checkMemsetZeroBytes();
+    /** @brief %Check for filling zero bytes with memset() (handler for 'memset') */
+    void checkMemsetZeroBytes(const Token *tok);
 
-    /** @brief %Check for invalid 2nd parameter of memset() */
-    void checkMemsetInvalid2ndParam();
+    /** @brief %Check for invalid 2nd parameter of memset() (handler for 'memset') */
+    void checkMemsetInvalid2ndParam(const Token *tok);
 
     /** @brief %Check for suspicious code where multiple if have the same expression (e.g "if (a) { } else if (a) { }") */
     void checkDuplicateIf();
@@ -51,6 +51,14 @@ public:
         checkPostfixOperator.postfixOperator();
     }
 
+    unsigned int phases() const {
+        return SIMPLIFIED;
+    }
+
+    unsigned int severities() const {
+        return severityBit(Severity::performance);
+    }
+
     /** Check postfix operators */
     void postfixOperator();
 
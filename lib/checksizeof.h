@@ -63,6 +63,10 @@ public:
     void runSimplifiedChecks(const Tokenizer*, const Settings*, ErrorLogger*) {
     }
 
+    unsigned int phases() const {
+        return NORMAL;
+    }
+
     /** @brief %Check for 'sizeof sizeof ..' */
     void sizeofsizeof();
 
@@ -20,6 +20,8 @@
 #include "executionpath.h"
 #include "symboldatabase.h"
 #include "checknullpointer.h"
+#include <list>
+#include <map>
 #include <sstream>
 
 // Register this check class (by creating a static instance of it)
@@ -65,46 +67,192 @@ static const Token *skipMembers(const Token *tok)
     return tok;
 }
 
-void CheckStl::iterators()
-{
-    const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
+namespace {
+    class IteratorStates;
 
-    // Using same iterator against different containers.
-    // for (it = foo.begin(); it != bar.end(); ++it)
-    for (unsigned int iteratorId = 1; iteratorId < symbolDatabase->getVariableListSize(); iteratorId++) {
-        const Variable* var = symbolDatabase->getVariableFromVarId(iteratorId);
+    /**
+     * @brief State machine of one iterator or pointer variable. It is only
+     * fed the tokens that can change its state.
+     */
+    class VariableTracker {
+    public:
+        explicit VariableTracker(const Token *end_) : end(end_), skipTo(nullptr), stamp(0), done(false) {
+        }
 
-        // Check that its an iterator
-        if (!var || !var->isLocal() || !Token::Match(var->typeEndToken(), "iterator|const_iterator|reverse_iterator|const_reverse_iterator|auto"))
-            continue;
+        virtual ~VariableTracker() {
+        }
 
-        if (var->typeEndToken()->str() == "auto" && !Token::Match(var->typeEndToken(), "auto %var% ; %var% = %var% . begin|end ( )"))
-            continue;
+        /**
+         * @brief parse a token
+         * @param tok the token
+         * @param states the analysis, for watching more variables and tokens
+         * @return the last token consumed (tok when nothing is skipped), or nullptr when tracking stops
+         */
+        virtual const Token *parse(const Token *tok, IteratorStates &states) = 0;
 
-        if (var->type()) { // If it is defined, ensure that it is defined like an iterator
-            // look for operator* and operator++
-            const Function* end = var->type()->getFunction("operator*");
-            const Function* incOperator = var->type()->getFunction("operator++");
-            if (!end || end->argCount() > 0 || !incOperator)
-                continue;
+        /** tracking stops at this token, it is not parsed */
+        const Token *end;
+
+        /** tokens up to and including this one are not parsed */
+        const Token *skipTo;
+
+        /** last token number the tracker was fed */
+        unsigned int stamp;
+
+        bool done;
+
+        std::vector<CheckStl::IteratorFinding> findings;
+    };
+
+    /**
+     * @brief Walks the tokens of a function once and feeds each token to the
+     * trackers it can affect: the trackers watching a variable at the token or
+     * a few tokens ahead of it, the trackers that asked to be woken at the token,
+     * and all trackers at statements that end or leave a branch.
+     */
+    class IteratorStates {
+    public:
+        IteratorStates() : _stamp(0) {
+        }
+
+        /** start tracking, the variable id is watched */
+        void track(VariableTracker *tracker, unsigned int varId) {
+            _trackers.push_back(tracker);
+            watch(varId, tracker);
+            wakeAt(tracker->end, tracker);
+        }
+
+        /** feed the tracker the tokens around uses of this variable */
+        void watch(unsigned int varId, VariableTracker *tracker) {
+            if (varId == 0)
+                return;
+            std::vector<VariableTracker *> &watchers = _watchers[varId];
+            if (watchers.empty() || watchers.back() != tracker)
+                watchers.push_back(tracker);
+        }
+
+        /** feed the tracker this token */
+        void wakeAt(const Token *tok, VariableTracker *tracker) {
+            if (tok)
+                _wakeups[tok].push_back(tracker);
+        }
+
+        void parse(const Token *tok) {
+            ++_stamp;
+            _fed.clear();
+
+            addWatchers(tok->varId());
+            if (tok->next()) {
+                addWatchers(tok->next()->varId());
+                const Token *tok4 = tok->tokAt(4);
+                if (tok4) {
+                    addWatchers(tok4->varId());
+                    if (tok4->next())
+                        addWatchers(tok4->next()->varId());
+                }
+            }
+
+            const std::map<const Token *, std::vector<VariableTracker *> >::iterator wakeup = _wakeups.find(tok);
+            if (wakeup != _wakeups.end()) {
+                add(wakeup->second);
+                _wakeups.erase(wakeup);
+            }
+
+            if (Token::Match(tok, "return|break|throw|else|for")) {
+                std::size_t live = 0;
+                for (std::size_t i = 0; i < _trackers.size(); ++i) {
+                    if (!_trackers[i]->done)
+                        _trackers[live++] = _trackers[i];
+                }
+                _trackers.resize(live);
+                add(_trackers);
+            }
+
+            for (std::size_t i = 0; i < _fed.size(); ++i)
+                feed(_fed[i], tok);
+        }
+
+    private:
+        void addWatchers(unsigned int varId) {
+            if (varId == 0)
+                return;
+            const std::map<unsigned int, std::vector<VariableTracker *> >::const_iterator watchers = _watchers.find(varId);
+            if (watchers != _watchers.end())
+                add(watchers->second);
+        }
+
+        void add(const std::vector<VariableTracker *> &trackers) {
+            for (std::size_t i = 0; i < trackers.size(); ++i) {
+                if (trackers[i]->stamp != _stamp) {
+                    trackers[i]->stamp = _stamp;
+                    _fed.push_back(trackers[i]);
+                }
+            }
         }
 
-        // the validIterator flag says if the iterator has a valid value or not
-        bool validIterator = Token::Match(var->nameToken()->next(), "[(=]");
-        const Scope* invalidationScope = 0;
+        void feed(VariableTracker *tracker, const Token *tok) {
+            if (tracker->done)
+                return;
+            if (tok == tracker->end) {
+                tracker->done = true;
+                return;
+            }
+            if (tracker->skipTo) {
+                if (tok == tracker->skipTo)
+                    tracker->skipTo = nullptr;
+                return;
+            }
+            const Token *last = tracker->parse(tok, *this);
+            if (!last)
+                tracker->done = true;
+            else if (last != tok) {
+                tracker->skipTo = last;
+                wakeAt(last, tracker);
+            }
+        }
 
-        // The container this iterator can be used with
-        const Variable* container = 0;
-        const Scope* containerAssignScope = 0;
+        unsigned int _stamp;
+        std::vector<VariableTracker *> _trackers;
+        std::vector<VariableTracker *> _fed;
+        std::map<unsigned int, std::vector<VariableTracker *> > _watchers;
+        std::map<const Token *, std::vector<VariableTracker *> > _wakeups;
+    };
 
-        // When "validatingToken" is reached the validIterator is set to true
-        const Token* validatingToken = 0;
+    /**
+     * @brief Validity of an iterator and the container it belongs to.
+     * Same iterator used with different containers, use of an erased iterator.
+     */
+    class IteratorUseTracker : public VariableTracker {
+    public:
+        explicit IteratorUseTracker(const Variable *var)
+            : VariableTracker(var->scope()->classEnd),
+              iteratorId(var->declarationId()),
+              validIterator(Token::Match(var->nameToken()->next(), "[(=]")),
+              invalidationScope(0),
+              container(0),
+              containerAssignScope(0),
+              validatingToken(0),
+              eraseToken(0) {
+        }
 
-        const Token* eraseToken = 0;
+        static bool isIterator(const Variable *var) {
+            if (!var->isLocal() || !Token::Match(var->typeEndToken(), "iterator|const_iterator|reverse_iterator|const_reverse_iterator|auto"))
+                return false;
 
-        // Scan through the rest of the code and see if the iterator is
-        // used against other containers.
-        for (const Token *tok2 = var->nameToken(); tok2 && tok2 != var->scope()->classEnd; tok2 = tok2->next()) {
+            if (var->typeEndToken()->str() == "auto" && !Token::Match(var->typeEndToken(), "auto %var% ; %var% = %var% . begin|end ( )"))
+                return false;
+
+            if (var->type()) { // If it is defined, ensure that it is defined like an iterator
+                // look for operator* and operator++
+                const Function* end = var->type()->getFunction("operator*");
+                const Function* incOperator = var->type()->getFunction("operator++");
+                if (!end || end->argCount() > 0 || !incOperator)
+                    return false;
+            }
+            return true;
+        }
+
+        const Token *parse(const Token *tok2, IteratorStates &states) {
             if (invalidationScope && tok2 == invalidationScope->classEnd)
                 validIterator = true; // Assume that the iterator becomes valid again
             if (containerAssignScope && tok2 == containerAssignScope->classEnd)
@@ -115,7 +263,7 @@ void CheckStl::iterators()
 
             // Is iterator compared against different container?
             if (Token::Match(tok2, "%varid% !=|== %var% . end|rend|cend|crend ( )", iteratorId) && container && tok2->tokAt(2)->varId() != container->declarationId()) {
-                iteratorsError(tok2, container->name(), tok2->strAt(2));
+                report(CheckStl::IteratorFinding::Iterators, tok2, 0, container->name(), tok2->strAt(2));
                 tok2 = tok2->tokAt(6);
             }
 
@@ -124,13 +272,13 @@ void CheckStl::iterators()
                 const Token* itTok = tok2->tokAt(4);
                 if (itTok->str() == "*") {
                     if (tok2->strAt(2) == "insert")
-                        continue;
+                        return tok2;
 
                     itTok = itTok->next();
                 }
                 // It is bad to insert/erase an invalid iterator
                 if (!validIterator)
-                    invalidIteratorError(tok2, itTok->str());
+                    report(CheckStl::IteratorFinding::InvalidIterator, tok2, 0, itTok->str(), emptyString);
 
                 // If insert/erase is used on different container then
                 // report an error
@@ -140,14 +288,14 @@ void CheckStl::iterators()
                     const Token *decltok = variableInfo ? variableInfo->typeStartToken() : nullptr;
 
                     if (Token::simpleMatch(decltok, "std :: set"))
-                        continue; // No warning
+                        return tok2; // No warning
 
                     // skip error message if the iterator is erased/inserted by value
                     if (itTok->previous()->str() == "*")
-                        continue;
+                        return tok2;
 
                     // Show error message, mismatching iterator is used.
-                    iteratorsError(tok2, container->name(), tok2->str());
+                    report(CheckStl::IteratorFinding::Iterators, tok2, 0, container->name(), tok2->str());
                 }
 
                 // invalidate the iterator if it is erased
@@ -155,6 +303,7 @@ void CheckStl::iterators()
                     validIterator = false;
                     eraseToken = tok2;
                     invalidationScope = tok2->scope();
+                    states.wakeAt(invalidationScope->classEnd, this);
                 }
 
                 // skip the operation
@@ -167,14 +316,17 @@ void CheckStl::iterators()
                      Token::simpleMatch(skipMembers(tok2->tokAt(2)), "erase (")) {
                 // the returned iterator is valid
                 validatingToken = tok2->linkAt(5);
+                states.wakeAt(validatingToken, this);
                 tok2 = tok2->tokAt(5);
             }
 
             // Reassign the iterator
             else if (Token::Match(tok2, "%varid% = %var% . begin|rbegin|cbegin|crbegin|find (", iteratorId)) {
                 validatingToken = tok2->linkAt(5);
+                states.wakeAt(validatingToken, this);
                 container = tok2->tokAt(2)->variable();
                 containerAssignScope = tok2->scope();
+                states.wakeAt(containerAssignScope->classEnd, this);
 
                 // skip ahead
                 tok2 = tok2->tokAt(5);
@@ -185,6 +337,7 @@ void CheckStl::iterators()
                 // Assume that the iterator becomes valid.
                 // TODO: add checking that checks if the iterator becomes valid or not
                 validatingToken = Token::findmatch(tok2->tokAt(2), "[;)]");
+                states.wakeAt(validatingToken, this);
 
                 // skip ahead
                 tok2 = tok2->tokAt(2);
@@ -197,10 +350,10 @@ void CheckStl::iterators()
 
             // Dereferencing invalid iterator?
             else if (!validIterator && Token::Match(tok2, "* %varid%", iteratorId)) {
-                dereferenceErasedError(eraseToken, tok2, tok2->strAt(1));
+                report(CheckStl::IteratorFinding::DereferenceErased, eraseToken, tok2, tok2->strAt(1), emptyString);
                 tok2 = tok2->next();
             } else if (!validIterator && Token::Match(tok2, "%varid% . %var%", iteratorId)) {
-                dereferenceErasedError(eraseToken, tok2, tok2->str());
+                report(CheckStl::IteratorFinding::DereferenceErased, eraseToken, tok2, tok2->str(), emptyString);
                 tok2 = tok2->tokAt(2);
             }
 
@@ -208,17 +361,286 @@ void CheckStl::iterators()
             // TODO: better handling
             else if (Token::Match(tok2, "return|break")) {
                 validatingToken = Token::findsimplematch(tok2->next(), ";");
+                states.wakeAt(validatingToken, this);
             }
 
             // bailout handling. Assume that the iterator becomes valid if we see else.
             // TODO: better handling
-            else if (tok2 && tok2->str() == "else") {
+            else if (tok2->str() == "else") {
                 validIterator = true;
             }
+
+            return tok2;
+        }
+
+    private:
+        void report(CheckStl::IteratorFinding::Kind kind, const Token *tok, const Token *tok2, const std::string &str1, const std::string &str2) {
+            findings.push_back(CheckStl::IteratorFinding(kind, tok, tok2, str1, str2));
+        }
+
+        unsigned int iteratorId;
+
+        /** does the iterator have a valid value? */
+        bool validIterator;
+        const Scope* invalidationScope;
+
+        /** The container this iterator can be used with */
+        const Variable* container;
+        const Scope* containerAssignScope;
+
+        /** When "validatingToken" is reached the validIterator is set to true */
+        const Token* validatingToken;
+
+        const Token* eraseToken;
+    };
+
+    /**
+     * @brief Pointer to a container element, invalid after push_back,
+     * push_front, insert, reserve, resize or clear
+     */
+    class ElementPointerTracker : public VariableTracker {
+    public:
+        explicit ElementPointerTracker(const Token *tok)
+            : VariableTracker(tok->scope()->classEnd),
+              pointerId(tok->varId()),
+              containerId(tok->tokAt(3)->varId()),
+              function(nullptr) {
+        }
+
+        unsigned int containerVarId() const {
+            return containerId;
+        }
+
+        const Token *parse(const Token *tok2, IteratorStates &) {
+            // push_back on vector..
+            if (Token::Match(tok2, "%varid% . push_front|push_back|insert|reserve|resize|clear", containerId))
+                function = tok2->tokAt(2);
+
+            // Using invalid pointer..
+            if (function && tok2->varId() == pointerId) {
+                bool unknown = false;
+                if (CheckNullPointer::isPointerDeRef(tok2, unknown))
+                    findings.push_back(CheckStl::IteratorFinding(CheckStl::IteratorFinding::InvalidPointer, tok2, 0, function->str(), tok2->str()));
+                return nullptr;
+            }
+            return tok2;
+        }
+
+    private:
+        unsigned int pointerId;
+        unsigned int containerId;
+
+        /** the call that invalidated the pointer */
+        const Token* function;
+    };
+
+    /**
+     * @brief Vector iterator, invalid after reserve, resize, insert,
+     * push_back or push_front on its vector
+     */
+    class VectorIteratorTracker : public VariableTracker {
+    public:
+        explicit VectorIteratorTracker(const Variable *var)
+            : VariableTracker(var->scope()->classEnd),
+              iteratorId(var->declarationId()),
+              name(var->name()),
+              vectorid(0),
+              validatingToken(0) {
+        }
+
+        static bool isIterator(const Variable *var) {
+            return var->isLocal() &&
+                   Token::Match(var->typeEndToken(), "iterator|const_iterator|reverse_iterator|const_reverse_iterator") &&
+                   Token::Match(var->typeStartToken(), "std| ::| vector <");
+        }
+
+        const Token *parse(const Token *tok2, IteratorStates &states) {
+            if (validatingToken == tok2) {
+                invalidIterator.clear();
+                validatingToken = 0;
+            }
+
+            // Using push_back or push_front inside a loop..
+            if (Token::simpleMatch(tok2, "for (")) {
+                tok2 = tok2->tokAt(2);
+            }
+
+            if (Token::Match(tok2, "%varid% = %var% . begin|rbegin|cbegin|crbegin ( ) ; %varid% != %var% . end|rend|cend|crend ( ) ; ++| %varid% ++| ) {", iteratorId)) {
+                // variable id for the loop iterator
+                const unsigned int varId(tok2->tokAt(2)->varId());
+                if (varId == 0)
+                    return tok2;
+
+                const Token *pushbackTok = nullptr;
+
+                // Count { and } for tok3
+                const Token *tok3 = tok2->tokAt(20);
+                for (const Token* const end3 = tok3->linkAt(-1); tok3 != end3; tok3 = tok3->next()) {
+                    if (tok3->str() == "break" || tok3->str() == "return") {
+                        pushbackTok = 0;
+                        break;
+                    } else if (Token::Match(tok3, "%varid% . push_front|push_back|insert|reserve|resize|clear|erase (", varId) && !tok3->previous()->isAssignmentOp()) {
+                        if (tok3->strAt(2) != "erase" || (tok3->tokAt(4)->varId() != iteratorId && tok3->tokAt(5)->varId() != iteratorId)) // This case is handled in: CheckStl::iterators()
+                            pushbackTok = tok3->tokAt(2);
+                    }
+                }
+
+                if (pushbackTok)
+                    report(pushbackTok, pushbackTok->str(), tok2->str());
+            }
+
+            // Assigning iterator..
+            if (Token::Match(tok2, "%varid% =", iteratorId)) {
+                if (Token::Match(tok2->tokAt(2), "%var% . begin|end|rbegin|rend|cbegin|cend|crbegin|crend|insert|erase|find (")) {
+                    if (!invalidIterator.empty() && Token::Match(tok2->tokAt(4), "insert|erase ( *| %varid% )|,", iteratorId)) {
+                        report(tok2, invalidIterator, name);
+                        return nullptr;
+                    }
+                    vectorid = tok2->tokAt(2)->varId();
+                    states.watch(vectorid, this);
+                    tok2 = tok2->linkAt(5);
+                } else {
+                    vectorid = 0;
+                }
+                invalidIterator = "";
+            }
+
+            // push_back on vector..
+            if (vectorid > 0 && Token::Match(tok2, "%varid% . push_front|push_back|insert|reserve|resize|clear|erase (", vectorid)) {
+                if (!invalidIterator.empty() && Token::Match(tok2->tokAt(2), "insert|erase ( *| %varid% ,|)", iteratorId)) {
+                    report(tok2, invalidIterator, name);
+                    return nullptr;
+                }
+
+                if (tok2->strAt(2) != "erase" || (tok2->tokAt(4)->varId() != iteratorId && tok2->tokAt(5)->varId() != iteratorId)) // This case is handled in: CheckStl::iterators()
+                    invalidIterator = tok2->strAt(2);
+                tok2 = tok2->linkAt(3);
+            }
+
+            else if (tok2->str() == "return" || tok2->str() == "throw") {
+                validatingToken = Token::findsimplematch(tok2->next(), ";");
+                states.wakeAt(validatingToken, this);
+            }
+
+            // TODO: instead of bail out for 'else' try to check all execution paths.
+            else if (tok2->str() == "break" || tok2->str() == "else")
+                invalidIterator.clear();
+
+            // Using invalid iterator..
+            if (!invalidIterator.empty()) {
+                if (Token::Match(tok2, "++|--|*|+|-|(|,|=|!= %varid%", iteratorId))
+                    report(tok2, invalidIterator, tok2->strAt(1));
+                if (Token::Match(tok2, "%varid% ++|--|+|-|.", iteratorId))
+                    report(tok2, invalidIterator, tok2->str());
+            }
+
+            return tok2;
+        }
+
+    private:
+        void report(const Token *tok, const std::string &func, const std::string &iterator_name) {
+            findings.push_back(CheckStl::IteratorFinding(CheckStl::IteratorFinding::InvalidatedIterator, tok, 0, func, iterator_name));
+        }
+
+        unsigned int iteratorId;
+        std::string name;
+
+        /** the variable id for the vector */
+        unsigned int vectorid;
+
+        const Token* validatingToken;
+
+        /** the call that invalidated the iterator */
+        std::string invalidIterator;
+    };
+}
+
+void CheckStl::analyseIterators()
+{
+    if (iteratorsAnalysed)
+        return;
+    iteratorsAnalysed = true;
+
+    const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
+
+    // The trackers are kept in the order their findings are reported
+    std::list<ElementPointerTracker> pointers;
+    std::map<unsigned int, IteratorUseTracker> iteratorUses;
+    std::map<unsigned int, VectorIteratorTracker> vectorIterators;
+    std::vector<bool> declared(symbolDatabase->getVariableListSize(), false);
+
+    const std::size_t functions = symbolDatabase->functionScopes.size();
+    for (std::size_t i = 0; i < functions; ++i) {
+        const Scope * scope = symbolDatabase->functionScopes[i];
+        IteratorStates states;
+        for (const Token* tok = scope->classStart->next(); tok != scope->classEnd; tok = tok->next()) {
+            // Pointer to container element
+            if (Token::Match(tok, "%var% = & %var% [") && tok->varId() != 0 && tok->tokAt(3)->varId() != 0) {
+                pointers.push_back(ElementPointerTracker(tok));
+                states.track(&pointers.back(), tok->varId());
+                states.watch(pointers.back().containerVarId(), &pointers.back());
+            }
+
+            // Iterator declaration
+            const unsigned int varId = tok->varId();
+            if (varId != 0 && varId < declared.size() && !declared[varId]) {
+                const Variable *var = symbolDatabase->getVariableFromVarId(varId);
+                if (var && var->nameToken() == tok) {
+                    declared[varId] = true;
+                    if (IteratorUseTracker::isIterator(var)) {
+                        VariableTracker *tracker = &iteratorUses.insert(std::make_pair(varId, IteratorUseTracker(var))).first->second;
+                        states.track(tracker, varId);
+                    }
+                    if (VectorIteratorTracker::isIterator(var)) {
+                        VariableTracker *tracker = &vectorIterators.insert(std::make_pair(varId, VectorIteratorTracker(var))).first->second;
+                        states.track(tracker, varId);
+                    }
+                }
+            }
+
+            states.parse(tok);
+        }
+    }
+
+    for (auto it = iteratorUses.cbegin(); it != iteratorUses.cend(); ++it)
+        iteratorsFindings.insert(iteratorsFindings.end(), it->second.findings.begin(), it->second.findings.end());
+    for (auto it = pointers.cbegin(); it != pointers.cend(); ++it)
+        pushbackFindings.insert(pushbackFindings.end(), it->findings.begin(), it->findings.end());
+    for (auto it = vectorIterators.cbegin(); it != vectorIterators.cend(); ++it)
+        pushbackFindings.insert(pushbackFindings.end(), it->second.findings.begin(), it->second.findings.end());
+}
+
+void CheckStl::reportIteratorFindings(const std::vector<IteratorFinding> &findings)
+{
+    for (auto it = findings.cbegin(); it != findings.cend(); ++it) {
+        switch (it->kind) {
+        case IteratorFinding::Iterators:
+            iteratorsError(it->tok, it->str1, it->str2);
+            break;
+        case IteratorFinding::InvalidIterator:
+            invalidIteratorError(it->tok, it->str1);
+            break;
+        case IteratorFinding::DereferenceErased:
+            dereferenceErasedError(it->tok, it->tok2, it->str1);
+            break;
+        case IteratorFinding::InvalidPointer:
+            invalidPointerError(it->tok, it->str1, it->str2);
+            break;
+        case IteratorFinding::InvalidatedIterator:
+            invalidIteratorError(it->tok, it->str1, it->str2);
+            break;
         }
     }
 }
 
+void CheckStl::iterators()
+{
+    // Using same iterator against different containers.
+    // for (it = foo.begin(); it != bar.end(); ++it)
+    analyseIterators();
+    reportIteratorFindings(iteratorsFindings);
+}
+
 
 // Error message for bad iterator usage..
 void CheckStl::mismatchingContainersError(const Token *tok)
@@ -363,6 +785,8 @@ void CheckStl::stlOutOfBoundsError(const Token *tok, const std::string &num, con
  */
 class EraseCheckLoop : public ExecutionPath {
 public:
+    using ExecutionPath::checkScope;
+
     static void checkScope(CheckStl *checkStl, const Token *it) {
         const Token *tok = it;
 
@@ -381,44 +805,28 @@ public:
         if (! Token::simpleMatch(tok, ") {"))
             return;
 
-        EraseCheckLoop c(checkStl, it->varId(), it);
-        std::list<ExecutionPath *> checks;
-        checks.push_back(c.copy());
-        ExecutionPath::checkScope(tok->tokAt(2), checks);
+        const EraseCheckLoop c(checkStl, it);
+        States checks;
+        checks.push_back(State(it->varId()));
+        c.checkScope(tok->tokAt(2), checks);
 
         c.end(checks, tok->link());
-
-        while (!checks.empty()) {
-            delete checks.back();
-            checks.pop_back();
-        }
     }
 
 private:
     /** Startup constructor */
-    EraseCheckLoop(Check *o, unsigned int varid, const Token* usetoken)
-        : ExecutionPath(o, varid), eraseToken(0), useToken(usetoken) {
+    EraseCheckLoop(Check *o, const Token* usetoken)
+        : ExecutionPath(o), useToken(usetoken) {
     }
 
-    /** @brief token where iterator is erased (non-zero => the iterator is invalid) */
-    const Token *eraseToken;
-
-    /** @brief name of the iterator */
+    /**
+     * @brief name of the iterator. The token where the iterator is
+     * erased is kept in State::tok (non-zero => the iterator is invalid)
+     */
     const Token* useToken;
 
-    /** @brief Copy this check. Called from the ExecutionPath baseclass. */
-    ExecutionPath *copy() {
-        return new EraseCheckLoop(*this);
-    }
-
-    /** @brief is another execution path equal? */
-    bool is_equal(const ExecutionPath *e) const {
-        const EraseCheckLoop *c = static_cast<const EraseCheckLoop *>(e);
-        return (eraseToken == c->eraseToken);
-    }
-
     /** @brief parse tokens */
-    const Token *parse(const Token &tok, std::list<ExecutionPath *> &checks) const {
+    const Token *parse(const Token &tok, States &checks) const {
         // bail out if there are assignments. We don't check the assignments properly.
         if (Token::Match(&tok, "[;{}] %var% =") || Token::Match(&tok, "= %var% ;")) {
             ExecutionPath::bailOutVar(checks, tok.next()->varId());
@@ -453,9 +861,8 @@ private:
 
                 // invalidate this iterator in the corresponding checks
                 for (auto it = checks.begin(); it != checks.end(); ++it) {
-                    EraseCheckLoop *c = dynamic_cast<EraseCheckLoop *>(*it);
-                    if (c && c->varId == iteratorId) {
-                        c->eraseToken = &tok;
+                    if (it->varId == iteratorId) {
+                        it->tok = &tok;
                     }
                 }
             }
@@ -471,7 +878,7 @@ private:
      * @param checks The execution paths. All execution paths in the list are executed in the current scope
      * @return true => bail out all checking
      **/
-    bool parseCondition(const Token &tok, std::list<ExecutionPath *> &checks) {
+    bool parseCondition(const Token &tok, States &checks) const {
         // no checking of conditions.
         (void)tok;
         (void)checks;
@@ -479,14 +886,13 @@ private:
     }
 
     /** @brief going out of scope - all execution paths end */
-    void end(const std::list<ExecutionPath *> &checks, const Token * /*tok*/) const {
+    void end(const States &checks, const Token * /*tok*/) const {
         // check if there are any invalid iterators. If so there is an error.
         for (auto it = checks.begin(); it != checks.end(); ++it) {
-            EraseCheckLoop *c = dynamic_cast<EraseCheckLoop *>(*it);
-            if (c && c->eraseToken) {
-                CheckStl *checkStl = dynamic_cast<CheckStl *>(c->owner);
+            if (it->tok) {
+                CheckStl *checkStl = dynamic_cast<CheckStl *>(owner);
                 if (checkStl) {
-                    checkStl->dereferenceErasedError(c->eraseToken, c->useToken, c->useToken->str());
+                    checkStl->dereferenceErasedError(it->tok, useToken, useToken->str());
                 }
             }
         }
@@ -540,142 +946,9 @@ void CheckStl::erase()
 void CheckStl::pushback()
 {
     // Pointer can become invalid after push_back, push_front, reserve or resize..
-    const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
-    const std::size_t functions = symbolDatabase->functionScopes.size();
-    for (std::size_t i = 0; i < functions; ++i) {
-        const Scope * scope = symbolDatabase->functionScopes[i];
-        for (const Token* tok = scope->classStart->next(); tok != scope->classEnd; tok = tok->next()) {
-            if (Token::Match(tok, "%var% = & %var% [")) {
-                // Variable id for pointer
-                const unsigned int pointerId(tok->varId());
-                if (pointerId == 0)
-                    continue;
-
-                // Variable id for the container variable
-                const unsigned int containerId(tok->tokAt(3)->varId());
-                if (containerId == 0)
-                    continue;
-
-                bool invalidPointer = false;
-                const Token* function = nullptr;
-                const Token* end2 = tok->scope()->classEnd;
-                for (const Token *tok2 = tok; tok2 != end2; tok2 = tok2->next()) {
-                    // push_back on vector..
-                    if (Token::Match(tok2, "%varid% . push_front|push_back|insert|reserve|resize|clear", containerId)) {
-                        invalidPointer = true;
-                        function = tok2->tokAt(2);
-                    }
-
-                    // Using invalid pointer..
-                    if (invalidPointer && tok2->varId() == pointerId) {
-                        bool unknown = false;
-                        if (CheckNullPointer::isPointerDeRef(tok2, unknown))
-                            invalidPointerError(tok2, function->str(), tok2->str());
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
     // Iterator becomes invalid after reserve, resize, insert, push_back or push_front..
-    for (unsigned int iteratorId = 1; iteratorId < symbolDatabase->getVariableListSize(); iteratorId++) {
-        const Variable* var = symbolDatabase->getVariableFromVarId(iteratorId);
-
-        // Check that its an iterator
-        if (!var || !var->isLocal() || !Token::Match(var->typeEndToken(), "iterator|const_iterator|reverse_iterator|const_reverse_iterator"))
-            continue;
-
-        // ... on std::vector
-        if (!Token::Match(var->typeStartToken(), "std| ::| vector <"))
-            continue;
-
-        // the variable id for the vector
-        unsigned int vectorid = 0;
-
-        const Token* validatingToken = 0;
-
-        std::string invalidIterator;
-        const Token* end2 = var->scope()->classEnd;
-        for (const Token *tok2 = var->nameToken(); tok2 != end2; tok2 = tok2->next()) {
-
-            if (validatingToken == tok2) {
-                invalidIterator.clear();
-                validatingToken = 0;
-            }
-
-            // Using push_back or push_front inside a loop..
-            if (Token::simpleMatch(tok2, "for (")) {
-                tok2 = tok2->tokAt(2);
-            }
-
-            if (Token::Match(tok2, "%varid% = %var% . begin|rbegin|cbegin|crbegin ( ) ; %varid% != %var% . end|rend|cend|crend ( ) ; ++| %varid% ++| ) {", iteratorId)) {
-                // variable id for the loop iterator
-                const unsigned int varId(tok2->tokAt(2)->varId());
-                if (varId == 0)
-                    continue;
-
-                const Token *pushbackTok = nullptr;
-
-                // Count { and } for tok3
-                const Token *tok3 = tok2->tokAt(20);
-                for (const Token* const end3 = tok3->linkAt(-1); tok3 != end3; tok3 = tok3->next()) {
-                    if (tok3->str() == "break" || tok3->str() == "return") {
-                        pushbackTok = 0;
-                        break;
-                    } else if (Token::Match(tok3, "%varid% . push_front|push_back|insert|reserve|resize|clear|erase (", varId) && !tok3->previous()->isAssignmentOp()) {
-                        if (tok3->strAt(2) != "erase" || (tok3->tokAt(4)->varId() != iteratorId && tok3->tokAt(5)->varId() != iteratorId)) // This case is handled in: CheckStl::iterators()
-                            pushbackTok = tok3->tokAt(2);
-                    }
-                }
-
-                if (pushbackTok)
-                    invalidIteratorError(pushbackTok, pushbackTok->str(), tok2->str());
-            }
-
-            // Assigning iterator..
-            if (Token::Match(tok2, "%varid% =", iteratorId)) {
-                if (Token::Match(tok2->tokAt(2), "%var% . begin|end|rbegin|rend|cbegin|cend|crbegin|crend|insert|erase|find (")) {
-                    if (!invalidIterator.empty() && Token::Match(tok2->tokAt(4), "insert|erase ( *| %varid% )|,", iteratorId)) {
-                        invalidIteratorError(tok2, invalidIterator, var->name());
-                        break;
-                    }
-                    vectorid = tok2->tokAt(2)->varId();
-                    tok2 = tok2->linkAt(5);
-                } else {
-                    vectorid = 0;
-                }
-                invalidIterator = "";
-            }
-
-            // push_back on vector..
-            if (vectorid > 0 && Token::Match(tok2, "%varid% . push_front|push_back|insert|reserve|resize|clear|erase (", vectorid)) {
-                if (!invalidIterator.empty() && Token::Match(tok2->tokAt(2), "insert|erase ( *| %varid% ,|)", iteratorId)) {
-                    invalidIteratorError(tok2, invalidIterator, var->name());
-                    break;
-                }
-
-                if (tok2->strAt(2) != "erase" || (tok2->tokAt(4)->varId() != iteratorId && tok2->tokAt(5)->varId() != iteratorId)) // This case is handled in: CheckStl::iterators()
-                    invalidIterator = tok2->strAt(2);
-                tok2 = tok2->linkAt(3);
-            }
-
-            else if (tok2->str() == "return" || tok2->str() == "throw")
-                validatingToken = Token::findsimplematch(tok2->next(), ";");
-
-            // TODO: instead of bail out for 'else' try to check all execution paths.
-            else if (tok2->str() == "break" || tok2->str() == "else")
-                invalidIterator.clear();
-
-            // Using invalid iterator..
-            if (!invalidIterator.empty()) {
-                if (Token::Match(tok2, "++|--|*|+|-|(|,|=|!= %varid%", iteratorId))
-                    invalidIteratorError(tok2, invalidIterator, tok2->strAt(1));
-                if (Token::Match(tok2, "%varid% ++|--|+|-|.", iteratorId))
-                    invalidIteratorError(tok2, invalidIterator, tok2->str());
-            }
-        }
-    }
+    analyseIterators();
+    reportIteratorFindings(pushbackFindings);
 }
 
 
@@ -1434,7 +1707,7 @@ void CheckStl::checkDereferenceInvalidIterator()
 
     // Iterate over "if", "while", and "for" conditions where there may
     // be an iterator that is dereferenced before being checked for validity.
-    const std::list<Scope>& scopeList = _tokenizer->getSymbolDatabase()->scopeList;
+    const std::deque<Scope>& scopeList = _tokenizer->getSymbolDatabase()->scopeList;
     for (auto i = scopeList.begin(); i != scopeList.end(); ++i) {
         if (i->type == Scope::eIf || i->type == Scope::eDo || i->type == Scope::eWhile || i->type == Scope::eFor) {
 
@@ -1514,7 +1787,7 @@ void CheckStl::readingEmptyStlContainer()
     static const char *MAP_STL_CONTAINERS[] = { "map", "multimap", "unordered_map", "unordered_multimap" };
     static const char *NONMAP_STL_CONTAINERS[] = { "deque", "forward_list", "list", "multiset", "queue", "set", "stack", "string", "unordered_multiset", "unordered_set", "vector" };
 
-    const std::list<Scope>& scopeList = _tokenizer->getSymbolDatabase()->scopeList;
+    const std::deque<Scope>& scopeList = _tokenizer->getSymbolDatabase()->scopeList;
 
     for (auto i = scopeList.begin(); i != scopeList.end(); ++i) {
         if (i->type != Scope::eFunction)
@@ -25,6 +25,9 @@
 #include "config.h"
 #include "check.h"
 
+#include <string>
+#include <vector>
+
 
 /// @addtogroup Checks
 /// @{
@@ -34,12 +37,12 @@
 class CPPCHECKLIB CheckStl : public Check {
 public:
     /** This constructor is used when registering the CheckClass */
-    CheckStl() : Check(myName()) {
+    CheckStl() : Check(myName()), iteratorsAnalysed(false) {
     }
 
     /** This constructor is used when running checks. */
     CheckStl(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
-        : Check(myName(), tokenizer, settings, errorLogger) {
+        : Check(myName(), tokenizer, settings, errorLogger), iteratorsAnalysed(false) {
     }
 
     /** Simplified checks. The token list is simplified. */
@@ -149,8 +152,36 @@ public:
     /** @brief Reading from empty stl container */
     void readingEmptyStlContainer();
 
+    /** @brief Diagnostic found by the iterator state analysis, reported by the check it belongs to */
+    struct IteratorFinding {
+        enum Kind { Iterators, InvalidIterator, DereferenceErased, InvalidPointer, InvalidatedIterator };
+
+        IteratorFinding(Kind kind_, const Token *tok_, const Token *tok2_, const std::string &str1_, const std::string &str2_)
+            : kind(kind_), tok(tok_), tok2(tok2_), str1(str1_), str2(str2_) {
+        }
+
+        Kind kind;
+        const Token *tok;
+        const Token *tok2;
+        std::string str1;
+        std::string str2;
+    };
+
 private:
 
+    /**
+     * Track the state of all iterators and invalidatable pointers
+     * (validity, invalidation, container) in one pass per function.
+     * The findings are reported by iterators() and pushback().
+     */
+    void analyseIterators();
+
+    void reportIteratorFindings(const std::vector<IteratorFinding> &findings);
+
+    bool iteratorsAnalysed;
+    std::vector<IteratorFinding> iteratorsFindings;
+    std::vector<IteratorFinding> pushbackFindings;
+
     /**
      * Helper function used by the 'erase' function
      * This function parses a loop
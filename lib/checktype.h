@@ -58,6 +58,10 @@ public:
         (void)errorLogger;
     }
 
+    unsigned int phases() const {
+        return NORMAL;
+    }
+
     /** @brief %Check for bitwise shift with too big right operand */
     void checkTooBigBitwiseShift();
 
@@ -56,25 +56,21 @@ class UninitVar : public ExecutionPath {
 public:
     /** Startup constructor */
     explicit UninitVar(Check *c, const SymbolDatabase* db, const Library *lib, bool isc)
-        : ExecutionPath(c, 0), symbolDatabase(db), library(lib), isC(isc), var(0), alloc(false), strncpy_(false), memset_nonzero(false) {
+        : ExecutionPath(c), symbolDatabase(db), library(lib), isC(isc) {
     }
 
 private:
-    /** Create a copy of this check */
-    ExecutionPath *copy() {
-        return new UninitVar(*this);
-    }
+    /** flags for the state of a variable */
+    enum Flags {
+        /** is this variable allocated? */
+        ALLOC = 1,
 
-    /** internal constructor for creating extra checks */
-    UninitVar(Check *c, const Variable* v, const SymbolDatabase* db, const Library *lib, bool isc)
-        : ExecutionPath(c, v->declarationId()), symbolDatabase(db), library(lib), isC(isc), var(v), alloc(false), strncpy_(false), memset_nonzero(false) {
-    }
+        /** is this variable initialized with strncpy (not always zero-terminated) */
+        STRNCPY = 2,
 
-    /** is other execution path equal? */
-    bool is_equal(const ExecutionPath *e) const {
-        const UninitVar *c = static_cast<const UninitVar *>(e);
-        return (var == c->var && alloc == c->alloc && strncpy_ == c->strncpy_ && memset_nonzero == c->memset_nonzero);
-    }
+        /** is this variable initialized but not zero-terminated (memset) */
+        MEMSET_NONZERO = 4
+    };
 
     /** pointer to symbol database */
     const SymbolDatabase* symbolDatabase;
@@ -85,26 +81,19 @@ private:
     const bool isC;
 
     /** variable for this check */
-    const Variable* var;
-
-    /** is this variable allocated? */
-    bool  alloc;
-
-    /** is this variable initialized with strncpy (not always zero-terminated) */
-    bool  strncpy_;
-
-    /** is this variable initialized but not zero-terminated (memset) */
-    bool  memset_nonzero;
+    const Variable *variable(const State &s) const {
+        return symbolDatabase->getVariableFromVarId(s.varId);
+    }
 
     /** allocating pointer. For example : p = malloc(10); */
-    static void alloc_pointer(std::list<ExecutionPath *> &checks, unsigned int varid) {
+    void alloc_pointer(States &checks, unsigned int varid) const {
         // loop through the checks and perform a allocation if the
         // variable id matches
         for (auto it = checks.begin(); it != checks.end(); ++it) {
-            UninitVar *c = dynamic_cast<UninitVar *>(*it);
-            if (c && c->varId == varid) {
-                if (c->var->isPointer() && !c->var->isArray())
-                    c->alloc = true;
+            if (it->varId == varid) {
+                const Variable *var = variable(*it);
+                if (var->isPointer() && !var->isArray())
+                    it->flags |= ALLOC;
                 else
                     bailOutVar(checks, varid);
                 break;
@@ -113,32 +102,30 @@ private:
     }
 
     /** Initializing a pointer value. For example: *p = 0; */
-    static void init_pointer(std::list<ExecutionPath *> &checks, const Token *tok) {
+    void init_pointer(States &checks, const Token *tok) const {
         const unsigned int varid(tok->varId());
         if (!varid)
             return;
 
         // loop through the checks and perform a initialization if the
         // variable id matches
-        auto it = checks.begin();
-        while (it != checks.end()) {
-            UninitVar *c = dynamic_cast<UninitVar *>(*it);
-            if (c && c->varId == varid) {
-                if (c->alloc || c->var->isArray()) {
-                    delete c;
-                    checks.erase(it++);
+        std::size_t i = 0;
+        while (i < checks.size()) {
+            if (checks[i].varId == varid) {
+                if ((checks[i].flags & ALLOC) || variable(checks[i])->isArray()) {
+                    checks.erase(checks.begin() + i);
                     continue;
                 } else {
                     use_pointer(checks, tok);
                 }
             }
 
-            ++it;
+            ++i;
         }
     }
 
     /** Deallocate a pointer. For example: free(p); */
-    static void dealloc_pointer(std::list<ExecutionPath *> &checks, const Token *tok) {
+    void dealloc_pointer(States &checks, const Token *tok) const {
         const unsigned int varid(tok->varId());
         if (!varid)
             return;
@@ -146,17 +133,17 @@ private:
         // loop through the checks and perform a deallocation if the
         // variable id matches
         for (auto it = checks.begin(); it != checks.end(); ++it) {
-            UninitVar *c = dynamic_cast<UninitVar *>(*it);
-            if (c && c->varId == varid) {
+            if (it->varId == varid) {
                 // unallocated pointer variable => error
-                if (c->var->isPointer() && !c->var->isArray() && !c->alloc) {
-                    CheckUninitVar *checkUninitVar = dynamic_cast<CheckUninitVar *>(c->owner);
+                const Variable *var = variable(*it);
+                if (var->isPointer() && !var->isArray() && !(it->flags & ALLOC)) {
+                    CheckUninitVar *checkUninitVar = dynamic_cast<CheckUninitVar *>(owner);
                     if (checkUninitVar) {
-                        checkUninitVar->uninitvarError(tok, c->var->name());
+                        checkUninitVar->uninitvarError(tok, var->name());
                         break;
                     }
                 }
-                c->alloc = false;
+                it->flags &= ~ALLOC;
             }
         }
     }
@@ -168,7 +155,7 @@ private:
      * \param tok1 the "p" token
      * \param tok2 the "x" token
      */
-    static void pointer_assignment(std::list<ExecutionPath *> &checks, const Token *tok1, const Token *tok2) {
+    void pointer_assignment(States &checks, const Token *tok1, const Token *tok2) const {
         // Variable id for "left hand side" variable
         const unsigned int varid1(tok1->varId());
         if (varid1 == 0)
@@ -181,8 +168,7 @@ private:
 
         // bail out if first variable is a pointer
         for (auto it = checks.begin(); it != checks.end(); ++it) {
-            UninitVar *c = dynamic_cast<UninitVar *>(*it);
-            if (c && c->varId == varid1 && c->var->isPointer() && !c->var->isArray()) {
+            if (it->varId == varid1 && variable(*it)->isPointer() && !variable(*it)->isArray()) {
                 bailOutVar(checks, varid1);
                 break;
             }
@@ -190,8 +176,7 @@ private:
 
         // bail out if second variable is a array/pointer
         for (auto it = checks.begin(); it != checks.end(); ++it) {
-            UninitVar *c = dynamic_cast<UninitVar *>(*it);
-            if (c && c->varId == varid2 && (c->var->isPointer() || c->var->isArray())) {
+            if (it->varId == varid2 && (variable(*it)->isPointer() || variable(*it)->isArray())) {
                 bailOutVar(checks, varid2);
                 break;
             }
@@ -200,29 +185,27 @@ private:
 
 
     /** Initialize an array with strncpy. */
-    static void init_strncpy(std::list<ExecutionPath *> &checks, const Token *tok) {
+    static void init_strncpy(States &checks, const Token *tok) {
         const unsigned int varid(tok->varId());
         if (!varid)
             return;
 
         for (auto it = checks.begin(); it != checks.end(); ++it) {
-            UninitVar *c = dynamic_cast<UninitVar *>(*it);
-            if (c && c->varId == varid) {
-                c->strncpy_ = true;
+            if (it->varId == varid) {
+                it->flags |= STRNCPY;
             }
         }
     }
 
     /** Initialize an array with memset (not zero). */
-    static void init_memset_nonzero(std::list<ExecutionPath *> &checks, const Token *tok) {
+    static void init_memset_nonzero(States &checks, const Token *tok) {
         const unsigned int varid(tok->varId());
         if (!varid)
             return;
 
         for (auto it = checks.begin(); it != checks.end(); ++it) {
-            UninitVar *c = dynamic_cast<UninitVar *>(*it);
-            if (c && c->varId == varid) {
-                c->memset_nonzero = true;
+            if (it->varId == varid) {
+                it->flags |= MEMSET_NONZERO;
             }
         }
     }
@@ -236,53 +219,57 @@ private:
      * @param mode specific behaviour
      * @return if error is found, true is returned
      */
-    static bool use(std::list<ExecutionPath *> &checks, const Token *tok, const int mode) {
+    bool use(const States &checks, const Token *tok, const int mode) const {
         const unsigned int varid(tok->varId());
         if (varid == 0)
             return false;
 
         for (auto it = checks.begin(); it != checks.end(); ++it) {
-            UninitVar *c = dynamic_cast<UninitVar *>(*it);
-            if (c && c->varId == varid) {
+            if (it->varId == varid) {
+                const Variable *var = variable(*it);
+                const bool alloc = (it->flags & ALLOC) != 0;
+                const bool strncpy_ = (it->flags & STRNCPY) != 0;
+                const bool memset_nonzero = (it->flags & MEMSET_NONZERO) != 0;
+
                 // mode 0 : the variable is used "directly"
                 // example: .. = var;
                 // it is ok to read the address of an uninitialized array.
                 // it is ok to read the address of an allocated pointer
-                if (mode == 0 && (c->var->isArray() || (c->var->isPointer() && c->alloc)))
+                if (mode == 0 && (var->isArray() || (var->isPointer() && alloc)))
                     continue;
 
                 // mode 2 : reading array data with mem.. function. It's ok if the
                 //          array is not null-terminated
-                if (mode == 2 && c->strncpy_)
+                if (mode == 2 && strncpy_)
                     continue;
 
                 // mode 3 : bad usage of pointer. if it's not a pointer then the usage is ok.
                 // example: ptr->foo();
-                if (mode == 3 && (!c->var->isPointer() || c->var->isArray()))
+                if (mode == 3 && (!var->isPointer() || var->isArray()))
                     continue;
 
                 // mode 4 : using dead pointer is invalid.
-                if (mode == 4 && (!c->var->isPointer() || c->var->isArray() || c->alloc))
+                if (mode == 4 && (!var->isPointer() || var->isArray() || alloc))
                     continue;
 
                 // mode 5 : reading uninitialized array or pointer is invalid.
-                if (mode == 5 && (!c->var->isArray() && !c->var->isPointer()))
+                if (mode == 5 && (!var->isArray() && !var->isPointer()))
                     continue;
 
-                CheckUninitVar *checkUninitVar = dynamic_cast<CheckUninitVar *>(c->owner);
+                CheckUninitVar *checkUninitVar = dynamic_cast<CheckUninitVar *>(owner);
                 if (checkUninitVar) {
-                    if (c->strncpy_ || c->memset_nonzero) {
-                        if (!Token::Match(c->var->typeStartToken(), "char|wchar_t")) {
+                    if (strncpy_ || memset_nonzero) {
+                        if (!Token::Match(var->typeStartToken(), "char|wchar_t")) {
                             continue;
                         }
                         if (Token::Match(tok->next(), "[")) { // Check if it's not being accessed like: 'str[1]'
                             continue;
                         }
-                        checkUninitVar->uninitstringError(tok, c->var->name(), c->strncpy_);
-                    } else if (c->var->isPointer() && !c->var->isArray() && c->alloc)
-                        checkUninitVar->uninitdataError(tok, c->var->name());
+                        checkUninitVar->uninitstringError(tok, var->name(), strncpy_);
+                    } else if (var->isPointer() && !var->isArray() && alloc)
+                        checkUninitVar->uninitdataError(tok, var->name());
                     else
-                        checkUninitVar->uninitvarError(tok, c->var->name());
+                        checkUninitVar->uninitvarError(tok, var->name());
                     return true;
                 }
             }
@@ -299,7 +286,7 @@ private:
      * @param tok variable token
      * @return if error is found, true is returned
      */
-    static bool use(std::list<ExecutionPath *> &checks, const Token *tok) {
+    bool use(const States &checks, const Token *tok) const {
         return use(checks, tok, 0);
     }
 
@@ -308,7 +295,7 @@ private:
      * @param checks all available checks
      * @param tok variable token
      */
-    static void use_array(std::list<ExecutionPath *> &checks, const Token *tok) {
+    void use_array(const States &checks, const Token *tok) const {
         use(checks, tok, 1);
     }
 
@@ -317,7 +304,7 @@ private:
      * @param checks all available checks
      * @param tok variable token
      */
-    static void use_array_mem(std::list<ExecutionPath *> &checks, const Token *tok) {
+    void use_array_mem(const States &checks, const Token *tok) const {
         use(checks, tok, 2);
     }
 
@@ -327,7 +314,7 @@ private:
      * @param tok variable token
      * @return if error is found, true is returned
      */
-    static bool use_pointer(std::list<ExecutionPath *> &checks, const Token *tok) {
+    bool use_pointer(const States &checks, const Token *tok) const {
         return use(checks, tok, 3);
     }
 
@@ -337,7 +324,7 @@ private:
      * @param tok variable token
      * @return if error is found, true is returned
      */
-    static bool use_dead_pointer(std::list<ExecutionPath *> &checks, const Token *tok) {
+    bool use_dead_pointer(const States &checks, const Token *tok) const {
         return use(checks, tok, 4);
     }
 
@@ -348,7 +335,7 @@ private:
      * @param tok variable token
      * @return if error is found, true is returned
      */
-    static bool use_array_or_pointer_data(std::list<ExecutionPath *> &checks, const Token *tok) {
+    bool use_array_or_pointer_data(const States &checks, const Token *tok) const {
         return use(checks, tok, 5);
     }
 
@@ -357,7 +344,7 @@ private:
      * @param tok2 start token of rhs
      * @param checks the execution paths
      */
-    static void parserhs(const Token *tok2, std::list<ExecutionPath *> &checks) {
+    void parserhs(const Token *tok2, States &checks) const {
         // check variable usages in rhs/index
         while (nullptr != (tok2 = tok2->next())) {
             if (Token::Match(tok2, "[;)=]"))
@@ -400,7 +387,7 @@ private:
     }
 
     /** parse tokens. @sa ExecutionPath::parse */
-    const Token *parse(const Token &tok, std::list<ExecutionPath *> &checks) const {
+    const Token *parse(const Token &tok, States &checks) const {
         // Variable declaration..
         if (tok.varId() && Token::Match(&tok, "%var% [[;]")) {
             const Variable* var2 = tok.variable();
@@ -424,11 +411,11 @@ private:
                 }
 
                 if (var2->isPointer())
-                    checks.push_back(new UninitVar(owner, var2, symbolDatabase, library, isC));
+                    checks.push_back(State(var2->declarationId()));
                 else if (var2->typeEndToken()->str() != ">") {
                     bool stdtype = var2->typeStartToken()->isStandardType(); // TODO: change to isC to handle unknown types better
                     if (stdtype && (!var2->isArray() || var2->nameToken()->linkAt(1)->strAt(1) == ";"))
-                        checks.push_back(new UninitVar(owner, var2, symbolDatabase, library, isC));
+                        checks.push_back(State(var2->declarationId()));
                 }
                 return &tok;
             }
@@ -475,9 +462,8 @@ private:
             if (Token::Match(tok.previous(), "[[(,+-*/|=] %var% ]|)|,|;|%op%") && !tok.next()->isAssignmentOp()) {
                 // Taking address of array..
                 for (auto it = checks.begin(); it != checks.end(); ++it) {
-                    UninitVar *c = dynamic_cast<UninitVar *>(*it);
-                    if (c && c->varId == tok.varId()) {
-                        if (c->var->isArray() || c->alloc)
+                    if (it->varId == tok.varId()) {
+                        if (variable(*it)->isArray() || (it->flags & ALLOC))
                             bailOutVar(checks, tok.varId());
                         break;
                     }
@@ -719,9 +705,9 @@ private:
                     if (Token::Match(tok2->previous(), "[,(] %var% [+-]")) {
                         // if var is array, bailout
                         for (auto it = checks.begin(); it != checks.end(); ++it) {
-                            if ((*it)->varId == tok2->varId()) {
-                                const UninitVar *c = dynamic_cast<const UninitVar *>(*it);
-                                if (c && (c->var->isArray() || (c->var->isPointer() && c->alloc)))
+                            if (it->varId == tok2->varId()) {
+                                const Variable *var = variable(*it);
+                                if (var->isArray() || (var->isPointer() && (it->flags & ALLOC)))
                                     bailouts.insert(tok2->varId());
                                 break;
                             }
@@ -865,7 +851,7 @@ private:
         return &tok;
     }
 
-    bool parseCondition(const Token &tok, std::list<ExecutionPath *> &checks) {
+    bool parseCondition(const Token &tok, States &checks) const {
         if (tok.varId() && Token::Match(&tok, "%var% <|<=|==|!=|)"))
             use(checks, &tok);
 
@@ -893,7 +879,7 @@ private:
         return ExecutionPath::parseCondition(tok, checks);
     }
 
-    void parseLoopBody(const Token *tok, std::list<ExecutionPath *> &checks) const {
+    void parseLoopBody(const Token *tok, States &checks) const {
         while (tok) {
             if (tok->str() == "{" || tok->str() == "}" || tok->str() == "for")
                 return;
@@ -1033,14 +1019,80 @@ void CheckUninitVar::executionPaths()
 }
 
 
+namespace {
+    /** Check the executable scopes in a parallel loop */
+    class CheckScopes : public ParallelLoop::Body {
+    public:
+        CheckScopes(CheckUninitVar *check, const std::vector<const Scope *> &scopes) : _check(check), _scopes(scopes) {
+        }
+        void run(std::size_t i) {
+            _check->checkScope(_scopes[i]);
+        }
+    private:
+        CheckUninitVar * const _check;
+        const std::vector<const Scope *> &_scopes;
+    };
+}
+
 void CheckUninitVar::check()
 {
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
 
-    // check every executable scope
+    // check every executable scope, in parallel with --check-threads
+    std::vector<const Scope *> scopes;
     for (auto scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
-        if (scope->isExecutable()) {
-            checkScope(&*scope);
+        if (scope->isExecutable())
+            scopes.push_back(&*scope);
+    }
+
+    ParallelLoop loop(_errorLogger, _settings);
+    CheckUninitVar checkUninitVar(_tokenizer, _settings, &loop);
+    checkUninitVar.testrunner = testrunner;
+    checkUninitVar.createStatementIndex();
+    CheckScopes body(&checkUninitVar, scopes);
+    loop.forEach(scopes.size(), body);
+}
+
+void CheckUninitVar::createStatementIndex()
+{
+    statements.clear();
+
+    const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
+    const std::size_t functions = symbolDatabase->functionScopes.size();
+    for (std::size_t i = 0; i < functions; ++i) {
+        const Scope * scope = symbolDatabase->functionScopes[i];
+        for (const Token *tok = scope->classStart; tok != scope->classEnd; tok = tok->next()) {
+            if (!Token::Match(tok, "[;{}]") || Token::Match(tok->next(), "[{};]"))
+                continue;
+
+            // variable values are tracked for such assignments
+            if (Token::Match(tok->next(), "%var% = - %var% ;"))
+                continue;
+
+            // only statements without control flow and inner scopes
+            unsigned int minVarId = ~0U, maxVarId = 0U;
+            const Token *tok2;
+            for (tok2 = tok->next(); tok2 && tok2->str() != ";"; tok2 = tok2->next()) {
+                if (Token::Match(tok2, "[{}]") || Token::Match(tok2, "if|for|while|do|asm|return|break|continue|throw|goto"))
+                    break;
+                if (tok2->varId()) {
+                    minVarId = std::min(minVarId, tok2->varId());
+                    maxVarId = std::max(maxVarId, tok2->varId());
+                }
+            }
+            if (!tok2 || tok2->str() != ";")
+                continue;
+
+            Statement &stmt = statements[tok->next()];
+            stmt.last = tok2;
+            stmt.firstVarId = minVarId;
+            if (maxVarId >= minVarId) {
+                stmt.varids.resize(maxVarId - minVarId + 1U);
+                for (tok2 = tok->next(); tok2 != stmt.last; tok2 = tok2->next()) {
+                    if (tok2->varId())
+                        stmt.varids[tok2->varId() - minVarId] = true;
+                }
+            }
         }
     }
 }
@@ -1202,6 +1254,15 @@ bool CheckUninitVar::checkScopeForVariable(const Scope* scope, const Token *tok,
     static const int NOT_ZERO = (1<<30); // special variable value
 
     for (; tok; tok = tok->next()) {
+        // indexed statement that doesn't use the variable..
+        if (Token::Match(tok->previous(), "[;{}]")) {
+            const std::unordered_map<const Token *, Statement>::const_iterator stmt = statements.find(tok);
+            if (stmt != statements.end() && !stmt->second.uses(var.declarationId())) {
+                tok = stmt->second.last;
+                continue;
+            }
+        }
+
         // End of scope..
         if (tok->str() == "}") {
             if (number_of_if && possibleInit)
@@ -1944,7 +2005,7 @@ void CheckUninitVar::deadPointer()
 {
     const bool cpp = _tokenizer->isCPP();
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
-    std::list<Scope>::const_iterator scope;
+    std::deque<Scope>::const_iterator scope;
 
     // check every executable scope
     for (scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
@@ -25,6 +25,9 @@
 #include "config.h"
 #include "check.h"
 
+#include <unordered_map>
+#include <vector>
+
 class Scope;
 class Variable;
 
@@ -32,7 +35,13 @@ class Variable;
 /// @{
 
 
-/** @brief Checking for uninitialized variables */
+/**
+ * @brief Checking for uninitialized variables
+ *
+ * The statements of all function bodies are indexed once with a bit vector
+ * of the variables they use, so checkScopeForVariable() can step over the
+ * statements that don't use the checked variable.
+ */
 
 class CPPCHECKLIB CheckUninitVar : public Check {
 public:
@@ -55,6 +64,7 @@ public:
 
     /** Check for uninitialized variables */
     void check();
+    void createStatementIndex();
     void checkScope(const Scope* scope);
     void checkStruct(const Scope* scope, const Token *tok, const Variable &structvar);
     bool checkScopeForVariable(const Scope* scope, const Token *tok, const Variable& var, bool * const possibleInit, bool * const noreturn, bool * const alloc, const std::string &membervar);
@@ -99,6 +109,25 @@ public:
     bool testrunner;
 
 private:
+    /** simple statement in a function body that checkScopeForVariable() can step over */
+    struct Statement {
+        /** last token (the ';') */
+        const Token *last;
+
+        /** variable id of the first bit in varids */
+        unsigned int firstVarId;
+
+        /** bit for each variable id that is used in the statement */
+        std::vector<bool> varids;
+
+        bool uses(unsigned int varid) const {
+            return varid >= firstVarId && varid - firstVarId < varids.size() && varids[varid - firstVarId];
+        }
+    };
+
+    /** statements, indexed by their first token */
+    std::unordered_map<const Token *, Statement> statements;
+
     void getErrorMessages(ErrorLogger *errorLogger, const Settings *settings) const {
         CheckUninitVar c(0, settings, errorLogger);
 
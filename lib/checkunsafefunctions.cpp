@@ -23,6 +23,8 @@
 #include "checkunsafefunctions.h"
 #include "symboldatabase.h"
 
+#include <set>
+
 //---------------------------------------------------------------------------
 
 
@@ -31,6 +33,69 @@ namespace {
     CheckUnsafeFunctions instance;
 }
 
+static const char * const unsafe_int_function_tips = "[CERT INT06-CPP] string token to integer";
+static const char * const raw_memory_function_tips = "[CERT MEM08-CPP] Raw memory";
+static const char * const FIO07_function_tips = "[CERT FIO07-CPP] Prefer fseek() to rewind()";
+static const char * const cstyle_fio_function_tips = "[CERT FIO17-CPP] C-style input and output";
+static const char * const cstyle_fio_stream_func_tips = "[CERT FIO12-CPP] Unsafe stream";
+static const char * const exception_func_tips = "[CERT ERR34-CPP] Do not use setjmp() or longjmp()";
+// Unsafe functions, which messages suggest only one alternative and doesn't contain additional information.
+static const struct {
+    const char* bad;
+    const char* good;
+    const char* prefix;
+} unsafe_stdmsgs[] = {
+    {"strcpy", "strncpy", "Obsolete"},
+    {"wcscpy", "wcsncpy", "Obsolete"},
+    {"strcat", "strncat", "Obsolete"},
+    {"sprintf", "snprintf", "Obsolete"},
+    {"vsprintf", "vsnprintf", "Obsolete"},
+    {"rewind", "fseek", FIO07_function_tips},
+    {"fopen", "fopen_s", "[CERT FIO06-CPP] Unsafe create file"},
+    {"malloc", "new and delete", raw_memory_function_tips},
+    {"calloc", "new and delete", raw_memory_function_tips},
+    {"realloc", "new and delete", raw_memory_function_tips},
+    {"free", "new and delete", raw_memory_function_tips},
+    {"fprintf", "C++ streams", cstyle_fio_function_tips},
+    {"fscanf", "C++ streams", cstyle_fio_function_tips},
+    {"printf", "C++ streams", cstyle_fio_function_tips},
+    {"scanf", "C++ streams", cstyle_fio_function_tips},
+    {"setbuf", "setvbuf", cstyle_fio_stream_func_tips},
+    {"system", "POSIX execve or other exec family", "[CERT ENV04-CPP] Unsafe C99 Command interpreter"},
+    {"rand", "random() on *nix or CryptGenRandom() on Windows", "[CERT MSC30-CPP] Generating pseudorandom numbers"},
+    {"setjmp", "throw and catch", exception_func_tips},
+    {"longjmp", "throw and catch", exception_func_tips},
+    {"atol", "strtol", unsafe_int_function_tips},
+    {"atoi", "strtol", unsafe_int_function_tips},
+    {"atoll", "strtoll", unsafe_int_function_tips},
+    {"sscanf", "strtoll", unsafe_int_function_tips},
+    {"scanf", "strtoll", unsafe_int_function_tips},
+    {"fscanf", "strtoll", unsafe_int_function_tips}
+};
+
+static CheckUnsafeFunctions::UnsafeFunctionMap createUnsafeFunctions()
+{
+    CheckUnsafeFunctions::UnsafeFunctionMap functions;
+    for (std::size_t i = 0; i < (sizeof(unsafe_stdmsgs) / sizeof(*unsafe_stdmsgs)); ++i) {
+        const CheckUnsafeFunctions::UnsafeFunction f = { unsafe_stdmsgs[i].good, unsafe_stdmsgs[i].prefix };
+        functions[unsafe_stdmsgs[i].bad] = f;
+    }
+    return functions;
+}
+
+const CheckUnsafeFunctions::UnsafeFunctionMap &CheckUnsafeFunctions::unsafeFunctionList()
+{
+    static const UnsafeFunctionMap functions(createUnsafeFunctions());
+    return functions;
+}
+
+std::string CheckUnsafeFunctions::unsafeFunctionMessage(const UnsafeFunctionMap::const_iterator &it)
+{
+    return std::string(it->second.prefix) + " function '" + it->first
+           + "' called. It is recommended to use the function '"
+           + it->second.good + "' instead.";
+}
+
 namespace {
 static bool isNotMemberFunction(const Token* tok)
 {
@@ -83,10 +148,11 @@ void CheckUnsafeFunctions::unsafeFunctions()
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
 
     // Functions defined somewhere?
-    for (unsigned int i = 0; i < symbolDatabase->functionScopes.size(); i++) {
-        const Scope* scope = symbolDatabase->functionScopes[i];
-        _unsafeFunctions.erase(scope->className);
-    }
+    std::set<std::string> definedFunctions;
+    for (unsigned int i = 0; i < symbolDatabase->functionScopes.size(); i++)
+        definedFunctions.insert(symbolDatabase->functionScopes[i]->className);
+
+    const UnsafeFunctionMap &functions = unsafeFunctionList();
 
     for (unsigned int i = 0; i < symbolDatabase->functionScopes.size(); i++) {
         const Scope* scope = symbolDatabase->functionScopes[i];
@@ -94,10 +160,10 @@ void CheckUnsafeFunctions::unsafeFunctions()
 			// Only check cpp file for unsafe functions
             if (_tokenizer->isCPP() && isFunctionCall(tok)) {
 
-                auto it = _unsafeFunctions.find(tok->str());
-                if (it != _unsafeFunctions.end()) {
+                auto it = functions.find(tok->str());
+                if (it != functions.end() && definedFunctions.find(it->first) == definedFunctions.end()) {
                     // If checking an old code base it might be uninteresting to update unsafe functions.
-                    reportError(tok, Severity::style, "unsafeFunctions"+it->first, it->second);
+                    reportError(tok, Severity::style, "unsafeFunctions"+it->first, unsafeFunctionMessage(it));
                 }
             }
 
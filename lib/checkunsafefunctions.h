@@ -38,13 +38,11 @@ class CPPCHECKLIB CheckUnsafeFunctions : public Check {
 public:
     /** This constructor is used when registering the CheckUnsafeFunctions */
     CheckUnsafeFunctions() : Check(myName()) {
-        initUnsafeFunctions();
     }
 
     /** This constructor is used when running checks. */
     CheckUnsafeFunctions(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
         : Check(myName(), tokenizer, settings, errorLogger) {
-        initUnsafeFunctions();
     }
 
     void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
@@ -55,67 +53,26 @@ public:
     /** Check for unsafe functions */
     void unsafeFunctions();
 
+    /** Catalog entry: the suggested replacement and the message prefix */
+    struct UnsafeFunction {
+        const char *good;
+        const char *prefix;
+    };
+    typedef std::map<std::string, UnsafeFunction> UnsafeFunctionMap;
+
 private:
-    /* function name / error message */
-    std::map<std::string, std::string> _unsafeFunctions;
-
-    /** init unsafe functions list ' */
-    void initUnsafeFunctions() {
-
-		const char* unsafe_int_function_tips = "[CERT INT06-CPP] string token to integer";
-		const char* raw_memory_function_tips = "[CERT MEM08-CPP] Raw memory";
-        const char* FIO07_function_tips = "[CERT FIO07-CPP] Prefer fseek() to rewind()";
-		const char* cstyle_fio_function_tips = "[CERT FIO17-CPP] C-style input and output";
-		const char* cstyle_fio_stream_func_tips = "[CERT FIO12-CPP] Unsafe stream";
-        const char* exception_func_tips = "[CERT ERR34-CPP] Do not use setjmp() or longjmp()";
-        // Unsafe functions, which messages suggest only one alternative and doesn't contain additional information.
-        const struct {
-            const char* bad;
-            const char* good;
-			const char* prefix;
-        } unsafe_stdmsgs[] = {
-            {"strcpy", "strncpy", "Obsolete"},
-			{"wcscpy", "wcsncpy", "Obsolete"},
-            {"strcat", "strncat", "Obsolete"},
-            {"sprintf", "snprintf", "Obsolete"},
-			{"vsprintf", "vsnprintf", "Obsolete"},
-			{"rewind", "fseek", FIO07_function_tips},
-			{"fopen", "fopen_s", "[CERT FIO06-CPP] Unsafe create file"},
-			{"malloc", "new and delete", raw_memory_function_tips},
-			{"calloc", "new and delete", raw_memory_function_tips},
-			{"realloc", "new and delete", raw_memory_function_tips},
-			{"free", "new and delete", raw_memory_function_tips},
-			{"fprintf", "C++ streams", cstyle_fio_function_tips},
-			{"fscanf", "C++ streams", cstyle_fio_function_tips},
-			{"printf", "C++ streams", cstyle_fio_function_tips},
-			{"scanf", "C++ streams", cstyle_fio_function_tips},
-			{"setbuf", "setvbuf", cstyle_fio_stream_func_tips},
-			{"system", "POSIX execve or other exec family", "[CERT ENV04-CPP] Unsafe C99 Command interpreter"},
-            {"rand", "random() on *nix or CryptGenRandom() on Windows", "[CERT MSC30-CPP] Generating pseudorandom numbers"},
-            {"setjmp", "throw and catch", exception_func_tips},
-			{"longjmp", "throw and catch", exception_func_tips},
-			{"atol", "strtol", unsafe_int_function_tips},
-			{"atoi", "strtol", unsafe_int_function_tips},
-            {"atoll", "strtoll", unsafe_int_function_tips},
-			{"sscanf", "strtoll", unsafe_int_function_tips},
-			{"scanf", "strtoll", unsafe_int_function_tips},
-			{"fscanf", "strtoll", unsafe_int_function_tips}
-        };
-
-		for (std::size_t i = 0; i < (sizeof(unsafe_stdmsgs) / sizeof(*unsafe_stdmsgs)); ++i) {
-			_unsafeFunctions[unsafe_stdmsgs[i].bad] = std::string(unsafe_stdmsgs[i].prefix) 
-				+ " function '" + std::string(unsafe_stdmsgs[i].bad) 
-				+ "' called. It is recommended to use the function '" 
-				+ unsafe_stdmsgs[i].good + "' instead.";
-        }
-    }
+    /** Function catalog. It is immutable and shared by all instances. */
+    static const UnsafeFunctionMap &unsafeFunctionList();
+
+    /** error message for a catalog entry */
+    static std::string unsafeFunctionMessage(const UnsafeFunctionMap::const_iterator &it);
 
     void getErrorMessages(ErrorLogger *errorLogger, const Settings *settings) const {
         CheckUnsafeFunctions c(0, settings, errorLogger);
 
-        auto it(_unsafeFunctions.begin()), itend(_unsafeFunctions.end());
-        for (; it!=itend; ++it) {
-            c.reportError(0, Severity::style, "unsafeFunctions"+it->first, it->second);
+        const UnsafeFunctionMap &functions = unsafeFunctionList();
+        for (auto it = functions.begin(); it != functions.end(); ++it) {
+            c.reportError(0, Severity::style, "unsafeFunctions"+it->first, unsafeFunctionMessage(it));
         }
     }
 
@@ -125,8 +82,8 @@ private:
 
     std::string classInfo() const {
         std::string info = "Warn if any of these unsafe functions are used:\n";
-        auto it(_unsafeFunctions.begin()), itend(_unsafeFunctions.end());
-        for (; it!=itend; ++it) {
+        const UnsafeFunctionMap &functions = unsafeFunctionList();
+        for (auto it = functions.begin(); it != functions.end(); ++it) {
             info += "* " + it->first + "\n";
         }
         return info;
@@ -70,24 +70,30 @@ void CheckUnusedFunctions::parseTokens(const Tokenizer &tokenizer, const char Fi
         }
     }
 
+    // Library configuration of this file type
+    const Library::CodeBlock * const executableblocks = settings->library.executableblocks(FileName);
+    const std::set<std::string> * const keywords = settings->library.keywords(FileName);
+    const std::set<std::string> * const importers = settings->library.importers(FileName);
+    const bool markupFile = settings->library.markupFile(FileName);
+
     // Function usage..
     for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
 
         // parsing of library code to find called functions
-        if (settings->library.isexecutableblock(FileName, tok->str())) {
-            const Token * markupVarToken = tok->tokAt(settings->library.blockstartoffset(FileName));
+        if (executableblocks && executableblocks->isBlock(tok->str())) {
+            const Token * markupVarToken = tok->tokAt(executableblocks->offset());
             int scope = 0;
             bool start = true;
             // find all function calls in library code (starts with '(', not if or while etc)
             while (scope || start) {
-                if (markupVarToken->str() == settings->library.blockstart(FileName)) {
+                if (markupVarToken->str() == executableblocks->start()) {
                     scope++;
                     if (start) {
                         start = false;
                     }
-                } else if (markupVarToken->str() == settings->library.blockend(FileName))
+                } else if (markupVarToken->str() == executableblocks->end())
                     scope--;
-                else if (!settings->library.iskeyword(FileName, markupVarToken->str())) {
+                else if (!keywords || !keywords->count(markupVarToken->str())) {
                     if (_functions.find(markupVarToken->str()) != _functions.end())
                         _functions[markupVarToken->str()].usedOtherFile = true;
                     else if (markupVarToken->next()->str() == "(") {
@@ -103,7 +109,7 @@ void CheckUnusedFunctions::parseTokens(const Tokenizer &tokenizer, const char Fi
             }
         }
 
-        if (!settings->library.markupFile(FileName) // only check source files
+        if (!markupFile // only check source files
             && settings->library.isexporter(tok->str()) && tok->next() != 0) {
             const Token * propToken = tok->next();
             while (propToken && propToken->str() != ")") {
@@ -125,8 +131,8 @@ void CheckUnusedFunctions::parseTokens(const Tokenizer &tokenizer, const char Fi
             }
         }
 
-        if (settings->library.markupFile(FileName)
-            && settings->library.isimporter(FileName, tok->str()) && tok->next()) {
+        if (markupFile
+            && importers && importers->count(tok->str()) > 0 && tok->next()) {
             const Token * propToken = tok->next();
             if (propToken->next()) {
                 propToken = propToken->next();
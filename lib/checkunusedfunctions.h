@@ -76,6 +76,11 @@ private:
 
     }
 
+    /** The unused functions are found by the whole program analysis */
+    unsigned int phases() const {
+        return 0;
+    }
+
     static std::string myName() {
         return "Unused functions";
     }
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cctype>
 #include <utility>
+#include <vector>
 //---------------------------------------------------------------------------
 
 // Register this check class (by creating a static instance of it)
@@ -30,8 +31,53 @@ namespace {
     CheckUnusedVar instance;
 }
 
+/**
+ * @brief Small set of values, kept sorted in a vector.
+ * The alias and assignment sets of a variable have few elements so this
+ * is faster than a std::set and it doesn't allocate a node per element.
+ */
+template<class T>
+class SmallSet {
+public:
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    const_iterator begin() const {
+        return _values.begin();
+    }
+    const_iterator end() const {
+        return _values.end();
+    }
+    bool empty() const {
+        return _values.empty();
+    }
+    std::size_t size() const {
+        return _values.size();
+    }
+    bool contains(T value) const {
+        return std::binary_search(_values.begin(), _values.end(), value);
+    }
+    void insert(T value) {
+        const typename std::vector<T>::iterator it = std::lower_bound(_values.begin(), _values.end(), value);
+        if (it == _values.end() || *it != value)
+            _values.insert(it, value);
+    }
+    void erase(T value) {
+        const typename std::vector<T>::iterator it = std::lower_bound(_values.begin(), _values.end(), value);
+        if (it != _values.end() && *it == value)
+            _values.erase(it);
+    }
+    void clear() {
+        _values.clear();
+    }
+
+private:
+    std::vector<T> _values;
+};
+
 /**
  * @brief This class is used create a list of variables within a function.
+ * The usage is stored in a table indexed by varid that is reused for
+ * all functions of a file.
  */
 class Variables {
 public:
@@ -67,8 +113,8 @@ public:
             return (_read == false && _write == false);
         }
 
-        std::set<unsigned int> _aliases;
-        std::set<const Scope*> _assignments;
+        SmallSet<unsigned int> _aliases;
+        SmallSet<const Scope*> _assignments;
 
         const Variable* _var;
         const Token* _lastAccess;
@@ -100,12 +146,18 @@ public:
         bool _insideLoop;
     };
 
-    void clear() {
-        _varUsage.clear();
+    /** @param varIds number of varids of the file, see SymbolDatabase::getVariableListSize() */
+    explicit Variables(std::size_t varIds) : _varUsage(varIds), _added(varIds, false) {
     }
-    const std::map<unsigned int, VariableUsage> &varUsage() const {
-        return _varUsage;
+
+    void clear() {
+        for (auto it = _addedVarIds.begin(); it != _addedVarIds.end(); ++it)
+            _added[*it] = false;
+        _addedVarIds.clear();
     }
+
+    /** The usage of the variables, ordered by varid */
+    std::vector<const VariableUsage *> varUsage() const;
     void addVar(const Variable *var, VariableType type, bool write_);
     void allocateMemory(unsigned int varid, const Token* tok);
     void read(unsigned int varid, const Token* tok);
@@ -119,7 +171,8 @@ public:
     VariableUsage *find(unsigned int varid);
     void alias(unsigned int varid1, unsigned int varid2, bool replace);
     void erase(unsigned int varid) {
-        _varUsage.erase(varid);
+        if (varid < _added.size())
+            _added[varid] = false;
     }
     void eraseAliases(unsigned int varid);
     void eraseAll(unsigned int varid);
@@ -133,7 +186,10 @@ private:
     void enterScope();
     void leaveScope(bool insideLoop);
 
-    std::map<unsigned int, VariableUsage> _varUsage;
+    /** usage of the variables, indexed by varid, only valid if _added[varid] is set */
+    std::vector<VariableUsage> _varUsage;
+    std::vector<bool> _added;
+    std::vector<unsigned int> _addedVarIds;
     std::list<std::set<unsigned int> > _varAddedInScope;
     std::list<std::set<unsigned int> > _varReadInScope;
 };
@@ -227,10 +283,32 @@ void Variables::addVar(const Variable *var,
                        VariableType type,
                        bool write_)
 {
-    if (var->declarationId() > 0) {
-        _varAddedInScope.back().insert(var->declarationId());
-        _varUsage.insert(std::make_pair(var->declarationId(), VariableUsage(var, type, false, write_, false)));
+    const unsigned int varid = var->declarationId();
+    if (varid > 0 && varid < _added.size()) {
+        _varAddedInScope.back().insert(varid);
+        if (!_added[varid]) {
+            _varUsage[varid] = VariableUsage(var, type, false, write_, false);
+            _added[varid] = true;
+            _addedVarIds.push_back(varid);
+        }
+    }
+}
+
+std::vector<const Variables::VariableUsage *> Variables::varUsage() const
+{
+    std::vector<unsigned int> varIds;
+    for (auto it = _addedVarIds.begin(); it != _addedVarIds.end(); ++it) {
+        if (_added[*it])
+            varIds.push_back(*it);
     }
+    std::sort(varIds.begin(), varIds.end());
+    varIds.erase(std::unique(varIds.begin(), varIds.end()), varIds.end());
+
+    std::vector<const VariableUsage *> usage;
+    usage.reserve(varIds.size());
+    for (auto it = varIds.begin(); it != varIds.end(); ++it)
+        usage.push_back(&_varUsage[*it]);
+    return usage;
 }
 
 void Variables::allocateMemory(unsigned int varid, const Token* tok)
@@ -352,11 +430,8 @@ void Variables::modified(unsigned int varid, const Token* tok)
 
 Variables::VariableUsage *Variables::find(unsigned int varid)
 {
-    if (varid) {
-        auto i = _varUsage.find(varid);
-        if (i != _varUsage.end())
-            return &i->second;
-    }
+    if (varid && varid < _added.size() && _added[varid])
+        return &_varUsage[varid];
     return 0;
 }
 
@@ -515,7 +590,7 @@ static const Token* doAssignment(Variables &variables, const Token *tok, bool de
                             // not in same scope as declaration
                             else {
                                 // no other assignment in this scope
-                                if (var1->_assignments.find(scope) == var1->_assignments.end() ||
+                                if (!var1->_assignments.contains(scope) ||
                                     scope->type == Scope::eSwitch) {
                                     // nothing to replace
                                     if (var1->_assignments.empty())
@@ -563,7 +638,7 @@ static const Token* doAssignment(Variables &variables, const Token *tok, bool de
                         variables.clearAliases(varid1);
                     else {
                         // no other assignment in this scope
-                        if (var1->_assignments.find(scope) == var1->_assignments.end()) {
+                        if (!var1->_assignments.contains(scope)) {
                             /**
                              * @todo determine if existing aliases should be discarded
                              */
@@ -614,18 +689,32 @@ static const Token* doAssignment(Variables &variables, const Token *tok, bool de
     return tok;
 }
 
-static bool isPartOfClassStructUnion(const Token* tok)
+bool CheckUnusedVar::isPartOfClassStructUnion(const Token* tok)
 {
+    // All statements of a block have the same result. Remember it for the
+    // passed ';' tokens so the block is only scanned once.
+    std::vector<const Token *> statements;
+    bool result = false;
     for (; tok; tok = tok->previous()) {
-        if (tok->str() == "}" || tok->str() == ")")
+        if (tok->str() == ";") {
+            const auto it = isPartOfClassStructUnionMap.find(tok);
+            if (it != isPartOfClassStructUnionMap.end()) {
+                result = it->second;
+                break;
+            }
+            statements.push_back(tok);
+        } else if (tok->str() == "}" || tok->str() == ")")
             tok = tok->link();
         else if (tok->str() == "(")
-            return (false);
+            break;
         else if (tok->str() == "{") {
-            return (tok->strAt(-1) == "struct" || tok->strAt(-2) == "struct" || tok->strAt(-1) == "class" || tok->strAt(-2) == "class" || tok->strAt(-1) == "union" || tok->strAt(-2) == "union");
+            result = (tok->strAt(-1) == "struct" || tok->strAt(-2) == "struct" || tok->strAt(-1) == "class" || tok->strAt(-2) == "class" || tok->strAt(-1) == "union" || tok->strAt(-2) == "union");
+            break;
         }
     }
-    return false;
+    for (auto it = statements.begin(); it != statements.end(); ++it)
+        isPartOfClassStructUnionMap[*it] = result;
+    return result;
 }
 
 // Skip [ .. ]
@@ -1067,22 +1156,22 @@ void CheckUnusedVar::checkFunctionVariableUsage()
     // Parse all executing scopes..
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
 
+    // varId, usage {read, write, modified}
+    Variables variables(symbolDatabase->getVariableListSize());
+
     // only check functions
     const std::size_t functions = symbolDatabase->functionScopes.size();
     for (std::size_t i = 0; i < functions; ++i) {
         const Scope * scope = symbolDatabase->functionScopes[i];
 
-        // varId, usage {read, write, modified}
-        Variables variables;
-
+        variables.clear();
         checkFunctionVariableUsage_iterateScopes(&*scope, variables, false);
 
 
         // Check usage of all variables in the current scope..
-        for (auto it = variables.varUsage().begin();
-             it != variables.varUsage().end();
-             ++it) {
-            const Variables::VariableUsage &usage = it->second;
+        const std::vector<const Variables::VariableUsage *> varUsage = variables.varUsage();
+        for (auto it = varUsage.begin(); it != varUsage.end(); ++it) {
+            const Variables::VariableUsage &usage = **it;
 
             // variable has been marked as unused so ignore it
             if (usage._var->nameToken()->isAttributeUnused() || usage._var->nameToken()->isAttributeUsed())
@@ -1095,7 +1184,7 @@ void CheckUnusedVar::checkFunctionVariableUsage()
                 continue;
 
             const std::string &varname = usage._var->name();
-            const Variable* var = symbolDatabase->getVariableFromVarId(it->first);
+            const Variable* var = symbolDatabase->getVariableFromVarId(usage._var->declarationId());
 
             // variable has had memory allocated for it, but hasn't done
             // anything with that memory other than, perhaps, freeing it
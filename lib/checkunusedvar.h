@@ -63,6 +63,14 @@ public:
         (void)errorLogger;
     }
 
+    unsigned int phases() const {
+        return NORMAL;
+    }
+
+    unsigned int severities() const {
+        return severityBit(Severity::style);
+    }
+
     /** @brief %Check for unused function variables */
     void checkFunctionVariableUsage_iterateScopes(const Scope* const scope, Variables& variables, bool insideLoop);
     void checkVariableUsage(const Scope* const scope, const Token* start, Variables& variables);
@@ -74,6 +82,7 @@ public:
 private:
     bool isRecordTypeWithoutSideEffects(const Type* type);
     bool isEmptyType(const Type* type);
+    bool isPartOfClassStructUnion(const Token* tok);
 
     // Error messages..
     void unusedStructMemberError(const Token *tok, const std::string &structname, const std::string &varname);
@@ -112,6 +121,9 @@ private:
 
     std::map<const Type *,bool> isEmptyTypeMap;
 
+    /** results of isPartOfClassStructUnion for the ';' tokens it has passed */
+    std::map<const Token *,bool> isPartOfClassStructUnionMap;
+
 };
 /// @}
 //---------------------------------------------------------------------------
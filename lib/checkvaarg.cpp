@@ -47,7 +47,7 @@ void CheckVaarg::va_start_argument()
                 if (var && var->isReference())
                     referenceAs_va_start_error(param2, var->name());
                 if (var && var->index() + 2 < function->argCount() && _settings->isEnabled("warning")) {
-                    std::list<Variable>::const_reverse_iterator it = function->argumentList.rbegin();
+                    std::deque<Variable>::const_reverse_iterator it = function->argumentList.rbegin();
                     ++it;
                     wrongParameterTo_va_start_error(tok, var->name(), it->name());
                 }
@@ -19,6 +19,7 @@
 
 #include "preprocessor.h" // Preprocessor
 #include "tokenize.h" // Tokenizer
+#include "symboldatabase.h"
 
 #include "check.h"
 #include "path.h"
@@ -246,6 +247,12 @@ unsigned int CppCheck::processFile(const std::string& filename, std::istream& fi
         internalError(filename, e.errorMessage);
     }
 
+    // Report the value flow costs of all configurations once
+    const std::list<std::string> costs(ValueFlow::costReport(valueFlowCosts));
+    for (auto it = costs.begin(); it != costs.end(); ++it)
+        _errorLogger.reportOut(*it);
+    valueFlowCosts.clear();
+
     if (_settings.isEnabled("information") || _settings.checkConfiguration)
         reportUnmatchedSuppressions(_settings.nomsg.getUnmatchedLocalSuppressions(filename, _settings._jobs == 1 && _settings.isEnabled("unusedFunction")));
 
@@ -306,8 +313,10 @@ bool CppCheck::checkFile(const std::string &code, const char FileName[], std::se
         return true;
 
     Tokenizer _tokenizer(&_settings, this);
-    if (_settings._showtime != SHOWTIME_NONE)
+    if (_settings._showtime != SHOWTIME_NONE) {
         _tokenizer.setTimerResults(&S_timerResults);
+        _tokenizer.setValueFlowCosts(&valueFlowCosts);
+    }
     try {
         // Execute rules for "raw" code
         for (auto it = _settings.rules.begin(); it != _settings.rules.end(); ++it) {
@@ -352,14 +361,13 @@ bool CppCheck::checkFile(const std::string &code, const char FileName[], std::se
             return true;
         }
 
-        // call all "runChecks" in all registered Check classes
-        for (auto it = Check::instances().begin(); it != Check::instances().end(); ++it) {
-            if (_settings.terminated())
-                return true;
+        // single pass over the tokens for the token handlers of all checks
+        runTokenHandlers(Check::NORMAL, _tokenizer);
 
-            Timer timerRunChecks((*it)->name() + "::runChecks", _settings._showtime, &S_timerResults);
-            (*it)->runChecks(&_tokenizer, &_settings, this);
-        }
+        // call all "runChecks" in all registered Check classes
+        runChecks(Check::NORMAL, _tokenizer);
+        if (_settings.terminated())
+            return true;
 
         // Analyse the tokens..
         for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it) {
@@ -379,14 +387,10 @@ bool CppCheck::checkFile(const std::string &code, const char FileName[], std::se
         if (!result)
             return true;
 
-        // call all "runSimplifiedChecks" in all registered Check classes
-        for (auto it = Check::instances().begin(); it != Check::instances().end(); ++it) {
-            if (_settings.terminated())
-                return true;
+        runTokenHandlers(Check::SIMPLIFIED, _tokenizer);
 
-            Timer timerSimpleChecks((*it)->name() + "::runSimplifiedChecks", _settings._showtime, &S_timerResults);
-            (*it)->runSimplifiedChecks(&_tokenizer, &_settings, this);
-        }
+        // call all "runSimplifiedChecks" in all registered Check classes
+        runChecks(Check::SIMPLIFIED, _tokenizer);
 
         if (_settings.terminated())
             return true;
@@ -420,6 +424,96 @@ bool CppCheck::checkFile(const std::string &code, const char FileName[], std::se
     return true;
 }
 
+void CppCheck::runTokenHandlers(Check::Phase phase, const Tokenizer &tokenizer)
+{
+    TokenDispatcher dispatcher(_settings._showtime, &S_timerResults);
+    for (auto it = Check::instances().begin(); it != Check::instances().end(); ++it) {
+        if ((*it)->isNeeded(phase, &_settings))
+            (*it)->subscribe(dispatcher, phase, &tokenizer, &_settings, this);
+    }
+    dispatcher.run(&tokenizer);
+}
+
+static void runCheck(Check *check, Check::Phase phase, const Tokenizer &tokenizer, const Settings &settings, ErrorLogger *errorLogger)
+{
+    if (phase == Check::NORMAL)
+        check->runChecks(&tokenizer, &settings, errorLogger);
+    else
+        check->runSimplifiedChecks(&tokenizer, &settings, errorLogger);
+}
+
+void CppCheck::runChecks(Check::Phase phase, const Tokenizer &tokenizer)
+{
+    std::vector<Check *> checks;
+    for (auto it = Check::instances().begin(); it != Check::instances().end(); ++it) {
+        if ((*it)->isNeeded(phase, &_settings))
+            checks.push_back(*it);
+    }
+
+    // serial with --showtime, --check-library and the debug options, see ParallelLoop::threads()
+    if (ParallelLoop::threads(&_settings) > 1U && checks.size() > 1U) {
+        runChecksConcurrently(phase, tokenizer, checks);
+        return;
+    }
+
+    const char * const suffix = (phase == Check::NORMAL) ? "::runChecks" : "::runSimplifiedChecks";
+    for (std::size_t i = 0; i < checks.size(); ++i) {
+        if (_settings.terminated())
+            return;
+
+        Timer timerRunChecks(checks[i]->name() + suffix, _settings._showtime, &S_timerResults);
+        runCheck(checks[i], phase, tokenizer, _settings, this);
+    }
+}
+
+namespace {
+    /** Run a range of checks in a parallel loop */
+    class RunChecks : public ParallelLoop::Body {
+    public:
+        RunChecks(Check * const *checks, Check::Phase phase, const Tokenizer &tokenizer, const Settings &settings, ErrorLogger *errorLogger)
+            : _checks(checks), _phase(phase), _tokenizer(tokenizer), _settings(settings), _errorLogger(errorLogger) {
+        }
+        void run(std::size_t i) {
+            if (!_settings.terminated())
+                runCheck(_checks[i], _phase, _tokenizer, _settings, _errorLogger);
+        }
+    private:
+        Check * const * const _checks;
+        const Check::Phase _phase;
+        const Tokenizer &_tokenizer;
+        const Settings &_settings;
+        ErrorLogger * const _errorLogger;
+    };
+}
+
+void CppCheck::runChecksConcurrently(Check::Phase phase, const Tokenizer &tokenizer, const std::vector<Check *> &checks)
+{
+    // The symbol database creates the list of function calls when it is
+    // first used. Create it before the checks share the symbol database.
+    tokenizer.getSymbolDatabase()->functionCallTokens();
+
+    // The thread safe checks between the other checks run in parallel
+    ParallelLoop loop(this, &_settings);
+    std::size_t i = 0;
+    while (i < checks.size()) {
+        if (_settings.terminated())
+            return;
+
+        if (!checks[i]->isThreadSafe()) {
+            runCheck(checks[i], phase, tokenizer, _settings, this);
+            ++i;
+            continue;
+        }
+
+        std::size_t end = i + 1U;
+        while (end < checks.size() && checks[end]->isThreadSafe())
+            ++end;
+        RunChecks body(&checks[i], phase, tokenizer, _settings, &loop);
+        loop.forEach(end - i, body);
+        i = end;
+    }
+}
+
 void CppCheck::executeRules(const std::string &tokenlist, const Tokenizer &tokenizer)
 {
     (void)tokenlist;
@@ -25,10 +25,12 @@
 #include "settings.h"
 #include "errorlogger.h"
 #include "check.h"
+#include "valueflow.h"
 
 #include <string>
 #include <list>
 #include <istream>
+#include <vector>
 
 class Tokenizer;
 
@@ -148,6 +150,15 @@ private:
     /** @brief Check file */
     bool checkFile(const std::string &code, const char FileName[], std::set<unsigned long long>& checksums);
 
+    /** @brief Call the token handlers of all checks in a single pass over the token list */
+    void runTokenHandlers(Check::Phase phase, const Tokenizer &tokenizer);
+
+    /** @brief Call runChecks() or runSimplifiedChecks() of all checks that are needed */
+    void runChecks(Check::Phase phase, const Tokenizer &tokenizer);
+
+    /** @brief Run the thread safe checks in parallel loops, the output is passed on in the order of the checks */
+    void runChecksConcurrently(Check::Phase phase, const Tokenizer &tokenizer, const std::vector<Check *> &checks);
+
     /**
      * @brief Execute rules, if any
      * @param tokenlist token list to use (normal / simple)
@@ -211,6 +222,9 @@ private:
 
     /** File info used for whole program analysis */
     std::list<Check::FileInfo*> fileInfo;
+
+    /** Costs of the value flow analysis of the current file, reported with --showtime */
+    ValueFlow::Costs valueFlowCosts;
 };
 
 /// @}
@@ -20,15 +20,12 @@
 #include "executionpath.h"
 #include "token.h"
 #include "symboldatabase.h"
-#include <memory>
 #include <set>
-#include <iterator>
-#include <iostream>
 
 
 
 // default : bail out if the condition is has variable handling
-bool ExecutionPath::parseCondition(const Token &tok, std::list<ExecutionPath *> & checks)
+bool ExecutionPath::parseCondition(const Token &tok, States &checks) const
 {
     unsigned int parlevel = 0;
     for (const Token *tok2 = &tok; tok2; tok2 = tok2->next()) {
@@ -45,38 +42,17 @@ bool ExecutionPath::parseCondition(const Token &tok, std::list<ExecutionPath *>
         }
     }
 
-    for (auto it = checks.begin(); it != checks.end();) {
-        if ((*it)->varId > 0 && (*it)->numberOfIf >= 1) {
-            delete *it;
-            checks.erase(it++);
-        } else {
-            ++it;
-        }
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < checks.size(); ++i) {
+        if (checks[i].varId == 0 || checks[i].numberOfIf == 0)
+            checks[n++] = checks[i];
     }
-
+    checks.resize(n, State(0));
 
     return false;
 }
 
 
-void ExecutionPath::print() const
-{
-    std::cout << " varId=" << varId
-              << " numberOfIf=" << numberOfIf
-              << "\n";
-}
-
-// I use this function when debugging ExecutionPaths with GDB
-/*
-static void printchecks(const std::list<ExecutionPath *> &checks)
-{
-    for (auto it = checks.begin(); it != checks.end(); ++it)
-        (*it)->print();
-}
-*/
-
-
-
 /**
  * @brief Parse If/Switch body recursively.
  * @param tok First token in body.
@@ -84,41 +60,37 @@ static void printchecks(const std::list<ExecutionPath *> &checks)
  * @param newchecks new checks
  * @param countif The countif set - count number of if for each execution path
  */
-static void parseIfSwitchBody(const Token * const tok,
-                              const std::list<ExecutionPath *> &checks,
-                              std::list<ExecutionPath *> &newchecks,
-                              std::set<unsigned int> &countif)
+void ExecutionPath::parseIfSwitchBody(const Token * const tok,
+                                      const States &checks,
+                                      States &newchecks,
+                                      std::set<unsigned int> &countif) const
 {
     std::set<unsigned int> countif2;
-    std::list<ExecutionPath *> c;
-    if (!checks.empty()) {
-        for (auto it = checks.begin(); it != checks.end(); ++it) {
-            if ((*it)->numberOfIf == 0)
-                c.push_back((*it)->copy());
-            if ((*it)->varId != 0)
-                countif2.insert((*it)->varId);
-        }
+    States c;
+    c.reserve(checks.size());
+    for (auto it = checks.begin(); it != checks.end(); ++it) {
+        if (it->numberOfIf == 0)
+            c.push_back(*it);
+        if (it->varId != 0)
+            countif2.insert(it->varId);
     }
-    ExecutionPath::checkScope(tok, c);
+    checkScope(tok, c);
     while (!c.empty()) {
-        if (c.back()->varId == 0) {
-            delete c.back();
+        if (c.back().varId == 0) {
             c.pop_back();
             continue;
         }
 
         bool duplicate = false;
         for (auto it = checks.begin(); it != checks.end(); ++it) {
-            if (*(*it) == *c.back() && (*it)->numberOfIf == c.back()->numberOfIf) {
+            if (*it == c.back()) {
                 duplicate = true;
-                countif2.erase((*it)->varId);
+                countif2.erase(it->varId);
                 break;
             }
         }
         if (!duplicate)
             newchecks.push_back(c.back());
-        else
-            delete c.back();
         c.pop_back();
     }
 
@@ -127,13 +99,11 @@ static void parseIfSwitchBody(const Token * const tok,
 }
 
 
-void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &checks)
+void ExecutionPath::checkScope(const Token *tok, States &checks) const
 {
     if (!tok || tok->str() == "}" || checks.empty())
         return;
 
-    const std::auto_ptr<ExecutionPath> check(checks.front()->copy());
-
     for (; tok; tok = tok->next()) {
         // might be a noreturn function..
         if (Token::simpleMatch(tok->tokAt(-2), ") ; }") &&
@@ -158,7 +128,7 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
 
         if (Token::simpleMatch(tok, "while (")) {
             // parse condition
-            if (checks.size() > 10 || check->parseCondition(*tok->tokAt(2), checks)) {
+            if (checks.size() > 10 || parseCondition(*tok->tokAt(2), checks)) {
                 ExecutionPath::bailOut(checks);
                 return;
             }
@@ -204,7 +174,7 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
 
             if (tok->str() == "switch") {
                 // parse condition
-                if (checks.size() > 10 || check->parseCondition(*tok->next(), checks)) {
+                if (checks.size() > 10 || parseCondition(*tok->next(), checks)) {
                     ExecutionPath::bailOut(checks);
                     return;
                 }
@@ -212,7 +182,7 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
                 // what variable ids should the if be counted for?
                 std::set<unsigned int> countif;
 
-                std::list<ExecutionPath *> newchecks;
+                States newchecks;
 
                 for (const Token* tok3 = tok2->next(); tok3; tok3 = tok3->next()) {
                     if (tok3->str() == "{")
@@ -226,12 +196,12 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
                 }
 
                 // Add newchecks to checks..
-                std::copy(newchecks.begin(), newchecks.end(), std::back_inserter(checks));
+                checks.insert(checks.end(), newchecks.begin(), newchecks.end());
 
                 // Increase numberOfIf
                 for (auto it = checks.begin(); it != checks.end(); ++it) {
-                    if (countif.find((*it)->varId) != countif.end())
-                        (*it)->numberOfIf++;
+                    if (countif.find(it->varId) != countif.end())
+                        it->numberOfIf++;
                 }
             }
             // no switch
@@ -242,13 +212,12 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
                 }
 
                 // it is not certain that a for/while will be executed:
-                for (auto it = checks.begin(); it != checks.end();) {
-                    if ((*it)->numberOfIf > 0) {
-                        delete *it;
-                        checks.erase(it++);
-                    } else
-                        ++it;
+                std::size_t n = 0;
+                for (std::size_t i = 0; i < checks.size(); ++i) {
+                    if (checks[i].numberOfIf == 0)
+                        checks[n++] = checks[i];
                 }
+                checks.resize(n, State(0));
 
                 // #2231 - loop body only contains a conditional initialization..
                 if (Token::simpleMatch(tok2->next(), "if (")) {
@@ -266,8 +235,8 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
                             const Token *t = Token::findsimplematch(tok3, ";");
                             if (t && t->tokAt(3) == tok4) {
                                 for (auto it = checks.begin(); it != checks.end(); ++it) {
-                                    if ((*it)->varId == tok3->next()->varId()) {
-                                        (*it)->numberOfIf++;
+                                    if (it->varId == tok3->next()->varId()) {
+                                        it->numberOfIf++;
                                         break;
                                     }
                                 }
@@ -279,7 +248,7 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
                 }
 
                 // parse loop bodies
-                check->parseLoopBody(tok2->next(), checks);
+                parseLoopBody(tok2->next(), checks);
             }
 
             // skip { .. }
@@ -364,7 +333,7 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
 
         // ; { ... }
         if (Token::Match(tok->previous(), "[;{}:] {")) {
-            ExecutionPath::checkScope(tok->next(), checks);
+            checkScope(tok->next(), checks);
             tok = tok->link();
             continue;
         }
@@ -373,13 +342,13 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
             // what variable ids should the numberOfIf be counted for?
             std::set<unsigned int> countif;
 
-            std::list<ExecutionPath *> newchecks;
+            States newchecks;
             while (tok->str() == "if" && tok->next() && tok->next()->str() == "(") {
                 // goto "("
                 tok = tok->next();
 
                 // parse condition
-                if (checks.size() > 10 || check->parseCondition(*tok->next(), checks)) {
+                if (checks.size() > 10 || parseCondition(*tok->next(), checks)) {
                     ExecutionPath::bailOut(checks);
                     ExecutionPath::bailOut(newchecks);
                     return;
@@ -417,7 +386,7 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
                     continue;
 
                 // there is no "if"..
-                ExecutionPath::checkScope(tok->next(), checks);
+                checkScope(tok->next(), checks);
                 tok = tok->link();
                 if (!tok) {
                     ExecutionPath::bailOut(newchecks);
@@ -426,26 +395,24 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
             }
 
             // Add newchecks to checks..
-            std::copy(newchecks.begin(), newchecks.end(), std::back_inserter(checks));
+            checks.insert(checks.end(), newchecks.begin(), newchecks.end());
 
             // Increase numberOfIf
             for (auto it = checks.begin(); it != checks.end(); ++it) {
-                if (countif.find((*it)->varId) != countif.end())
-                    (*it)->numberOfIf++;
+                if (countif.find(it->varId) != countif.end())
+                    it->numberOfIf++;
             }
 
             // Delete checks that have numberOfIf >= 2
-            for (auto it = checks.begin(); it != checks.end();) {
-                if ((*it)->varId > 0 && (*it)->numberOfIf >= 2) {
-                    delete *it;
-                    checks.erase(it++);
-                } else {
-                    ++it;
-                }
+            std::size_t n = 0;
+            for (std::size_t i = 0; i < checks.size(); ++i) {
+                if (checks[i].varId == 0 || checks[i].numberOfIf < 2)
+                    checks[n++] = checks[i];
             }
+            checks.resize(n, State(0));
         }
 
-        tok = check->parse(*tok, checks);
+        tok = parse(*tok, checks);
         if (!tok || checks.empty())
             return;
 
@@ -459,23 +426,17 @@ void ExecutionPath::checkScope(const Token *tok, std::list<ExecutionPath *> &che
     }
 }
 
-void checkExecutionPaths(const SymbolDatabase *symbolDatabase, ExecutionPath *c)
+void checkExecutionPaths(const SymbolDatabase *symbolDatabase, const ExecutionPath *c)
 {
     for (auto i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
         if (i->type != Scope::eFunction || !i->classStart)
             continue;
 
         // Check function
-        std::list<ExecutionPath *> checks;
-        checks.push_back(c->copy());
-        ExecutionPath::checkScope(i->classStart, checks);
+        ExecutionPath::States checks;
+        checks.push_back(ExecutionPath::State(0));
+        c->checkScope(i->classStart, checks);
 
         c->end(checks, i->classEnd);
-
-        // Cleanup
-        while (!checks.empty()) {
-            delete checks.back();
-            checks.pop_back();
-        }
     }
 }
@@ -21,7 +21,8 @@
 #define executionpathH
 //---------------------------------------------------------------------------
 
-#include <list>
+#include <set>
+#include <vector>
 #include "config.h"
 
 class Token;
@@ -31,45 +32,58 @@ class SymbolDatabase;
 /**
  * Base class for Execution Paths checking
  * An execution path is a linear list of statements. There are no "if"/.. to worry about.
+ *
+ * The derived class implements the parsing. The state of each variable on
+ * each execution path is a small value, so forking the paths at a branch
+ * copies a vector and merging the branches appends the states that differ.
  **/
 class CPPCHECKLIB ExecutionPath {
 private:
     /** No implementation */
+    ExecutionPath(const ExecutionPath &);
     ExecutionPath& operator=(const ExecutionPath &);
 
 protected:
     Check * const owner;
 
-    /** Are two execution paths equal? */
-    virtual bool is_equal(const ExecutionPath *) const = 0;
-
 public:
-    ExecutionPath(Check *c, unsigned int id) : owner(c), numberOfIf(0), varId(id) {
-    }
+    /** State of a variable on an execution path */
+    struct State {
+        explicit State(unsigned int id) : varId(id), numberOfIf(0), flags(0), tok(nullptr) {
+        }
 
-    virtual ~ExecutionPath() {
-    }
+        /** variable id. The state with id 0 keeps the execution path alive */
+        unsigned int varId;
+
+        /** number of if blocks */
+        unsigned int numberOfIf;
+
+        /** check specific flags */
+        unsigned int flags;
 
-    /** Implement this in each derived class. This function must create a copy of the current instance */
-    virtual ExecutionPath *copy() = 0;
+        /** check specific token */
+        const Token *tok;
 
-    /** print checkdata */
-    void print() const;
+        bool operator==(const State &s) const {
+            return varId == s.varId && numberOfIf == s.numberOfIf && flags == s.flags && tok == s.tok;
+        }
+    };
+
+    /** The states of all execution paths that are executed in the current scope */
+    typedef std::vector<State> States;
 
-    /** number of if blocks */
-    unsigned int numberOfIf;
+    explicit ExecutionPath(Check *c) : owner(c) {
+    }
 
-    const unsigned int varId;
+    virtual ~ExecutionPath() {
+    }
 
     /**
      * bail out all execution paths
      * @param checks the execution paths to bail out on
      **/
-    static void bailOut(std::list<ExecutionPath *> &checks) {
-        while (!checks.empty()) {
-            delete checks.back();
-            checks.pop_back();
-        }
+    static void bailOut(States &checks) {
+        checks.clear();
     }
 
     /**
@@ -77,19 +91,16 @@ public:
      * @param checks the execution paths to bail out on
      * @param varid the specific variable id
      **/
-    static void bailOutVar(std::list<ExecutionPath *> &checks, const unsigned int varid) {
+    static void bailOutVar(States &checks, const unsigned int varid) {
         if (varid == 0)
             return;
 
-        auto it = checks.begin();
-        while (it != checks.end()) {
-            if ((*it)->varId == varid) {
-                delete *it;
-                checks.erase(it++);
-            } else {
-                ++it;
-            }
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < checks.size(); ++i) {
+            if (checks[i].varId != varid)
+                checks[n++] = checks[i];
         }
+        checks.resize(n, State(0));
     }
 
     /**
@@ -98,7 +109,7 @@ public:
      * @param checks The execution paths. All execution paths in the list are executed in the current scope.
      * @return the token before the "next" token.
      **/
-    virtual const Token *parse(const Token &tok, std::list<ExecutionPath *> &checks) const = 0;
+    virtual const Token *parse(const Token &tok, States &checks) const = 0;
 
     /**
      * Parse condition
@@ -106,31 +117,33 @@ public:
      * @param checks The execution paths. All execution paths in the list are executed in the current scope
      * @return true => bail out all checking
      **/
-    virtual bool parseCondition(const Token &tok, std::list<ExecutionPath *> &checks);
+    virtual bool parseCondition(const Token &tok, States &checks) const;
 
     /**
      * Parse loop body
      * @param tok the first token in the loop body (the token after the {)
      * @param checks The execution paths
      */
-    virtual void parseLoopBody(const Token *tok, std::list<ExecutionPath *> &checks) const {
+    virtual void parseLoopBody(const Token *tok, States &checks) const {
         (void)tok;
         (void)checks;
     }
 
     /** going out of scope - all execution paths end */
-    virtual void end(const std::list<ExecutionPath *> & /*checks*/, const Token * /*tok*/) const {
+    virtual void end(const States & /*checks*/, const Token * /*tok*/) const {
     }
 
-    bool operator==(const ExecutionPath &e) const {
-        return bool(varId == e.varId && is_equal(&e));
-    }
+    void checkScope(const Token *tok, States &checks) const;
 
-    static void checkScope(const Token *tok, std::list<ExecutionPath *> &checks);
+private:
+    void parseIfSwitchBody(const Token * const tok,
+                           const States &checks,
+                           States &newchecks,
+                           std::set<unsigned int> &countif) const;
 };
 
 
-void checkExecutionPaths(const SymbolDatabase *symbolDatabase, ExecutionPath *c);
+void checkExecutionPaths(const SymbolDatabase *symbolDatabase, const ExecutionPath *c);
 
 //---------------------------------------------------------------------------
 #endif // executionpathH
@@ -23,14 +23,70 @@
 #include "mathlib.h"
 #include "token.h"
 #include "symboldatabase.h"
+#include "version.h"
 
 #include <string>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
 
 Library::Library() : allocid(0)
 {
 }
 
+/** read the rest of the file and close it */
+static bool readFile(std::FILE *f, std::string &data)
+{
+    char buf[4096];
+    std::size_t len;
+    while ((len = std::fread(buf, 1, sizeof(buf), f)) > 0)
+        data.append(buf, len);
+    const bool readerror = (std::ferror(f) != 0);
+    std::fclose(f);
+    return !readerror;
+}
+
+/** FNV-1a hash of the contents of a configuration file */
+static unsigned long long hash(const std::string &data)
+{
+    unsigned long long h = 14695981039346656037ULL;
+    for (std::string::size_type i = 0; i < data.size(); ++i) {
+        h ^= (unsigned char)data[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/** configuration loaded from in-memory documents can't be matched with an image */
+static bool imageable(const std::vector<std::pair<std::string, unsigned long long> > &sources)
+{
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i].first.empty())
+            return false;
+    }
+    return true;
+}
+
+static std::string imageFilename(const std::string &cachedir, const std::vector<std::pair<std::string, unsigned long long> > &sources)
+{
+    std::string key;
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        key += sources[i].first + '\0';
+        for (int shift = 0; shift < 64; shift += 8)
+            key += (char)(sources[i].second >> shift);
+    }
+    const unsigned long long h = hash(key);
+    char name[32];
+    std::sprintf(name, "library-%08x%08x.bin", (unsigned int)(h >> 32), (unsigned int)(h & 0xffffffffU));
+    const char *sep = (cachedir[cachedir.size()-1U]=='/' ? "" : "/");
+    return cachedir + sep + name;
+}
+
 Library::Error Library::load(const char exename[], const char path[])
 {
     if (std::strchr(path,',') != nullptr) {
@@ -47,50 +103,81 @@ Library::Error Library::load(const char exename[], const char path[])
         return Error();
     }
 
-    std::string absolute_path;
-    // open file..
-    tinyxml2::XMLDocument doc;
-    tinyxml2::XMLError error = doc.LoadFile(path);
-    if (error == tinyxml2::XML_ERROR_FILE_NOT_FOUND) {
+    // locate file..
+    std::string filename(path);
+    std::FILE *f = std::fopen(filename.c_str(), "rb");
+    if (!f && Path::getFilenameExtension(filename) == "") {
         // failed to open file.. is there no extension?
-        std::string fullfilename(path);
-        if (Path::getFilenameExtension(fullfilename) == "") {
-            fullfilename += ".cfg";
-            error = doc.LoadFile(fullfilename.c_str());
-            if (error != tinyxml2::XML_ERROR_FILE_NOT_FOUND)
-                absolute_path = Path::getAbsoluteFilePath(fullfilename.c_str());
-        }
-
-        if (error == tinyxml2::XML_ERROR_FILE_NOT_FOUND) {
-            // Try to locate the library configuration in the installation folder..
+        filename += ".cfg";
+        f = std::fopen(filename.c_str(), "rb");
+    }
+    if (!f) {
+        // Try to locate the library configuration in the installation folder..
 #ifdef CFGDIR
-            const std::string cfgfolder(CFGDIR);
+        const std::string cfgfolder(CFGDIR);
 #else
-            if (!exename)
-                return Error(FILE_NOT_FOUND);
-            const std::string cfgfolder(Path::fromNativeSeparators(Path::getPathFromFilename(exename)) + "cfg");
+        if (!exename)
+            return Error(FILE_NOT_FOUND);
+        const std::string cfgfolder(Path::fromNativeSeparators(Path::getPathFromFilename(exename)) + "cfg");
 #endif
-            const char *sep = (!cfgfolder.empty() && cfgfolder[cfgfolder.size()-1U]=='/' ? "" : "/");
-            const std::string filename(cfgfolder + sep + fullfilename);
-            error = doc.LoadFile(filename.c_str());
-            if (error != tinyxml2::XML_ERROR_FILE_NOT_FOUND)
-                absolute_path = Path::getAbsoluteFilePath(filename.c_str());
-        }
-    } else
-        absolute_path = Path::getAbsoluteFilePath(path);
-
-    if (error == tinyxml2::XML_NO_ERROR) {
-        if (_files.find(absolute_path) == _files.end()) {
-            Error err = load(doc);
-            if (err.errorcode == OK)
-                _files.insert(absolute_path);
-            return err;
-        }
+        const char *sep = (!cfgfolder.empty() && cfgfolder[cfgfolder.size()-1U]=='/' ? "" : "/");
+        filename = cfgfolder + sep + filename;
+        f = std::fopen(filename.c_str(), "rb");
+        if (!f)
+            return Error(FILE_NOT_FOUND);
+    }
 
+    const std::string absolute_path(Path::getAbsoluteFilePath(filename.c_str()));
+    if (_files.find(absolute_path) != _files.end()) {
+        std::fclose(f);
         return Error(OK); // ignore duplicates
     }
 
-    return Error(error == tinyxml2::XML_ERROR_FILE_NOT_FOUND ? FILE_NOT_FOUND : BAD_XML);
+    std::string data;
+    if (!readFile(f, data))
+        return Error(BAD_XML);
+
+    std::vector<std::pair<std::string, unsigned long long> > sources(_sources);
+    sources.push_back(std::make_pair(absolute_path, hash(data)));
+
+    // is there an image of the configuration with this file loaded?
+    std::string imagefile;
+    if (!_cachedir.empty() && imageable(sources)) {
+        imagefile = imageFilename(_cachedir, sources);
+        std::FILE *fimage = std::fopen(imagefile.c_str(), "rb");
+        std::string imagedata;
+        Library image;
+        if (fimage && readFile(fimage, imagedata) && image.loadimage(imagedata.data(), imagedata.size()) && image._sources == sources) {
+            image._cachedir = _cachedir;
+            *this = std::move(image);
+            return Error(OK);
+        }
+    }
+
+    tinyxml2::XMLDocument doc;
+    if (doc.Parse(data.c_str(), data.size()) != tinyxml2::XML_NO_ERROR)
+        return Error(BAD_XML);
+
+    const Error err = loadDocument(doc);
+    resolveFunctions();
+    if (err.errorcode != OK)
+        return err;
+    _files.insert(absolute_path);
+    _sources.swap(sources);
+
+    if (!imagefile.empty()) {
+        // write to a temporary file first so other processes never read a partial image
+        const std::string tmpfile(imagefile + ".tmp");
+        bool written;
+        {
+            std::ofstream fout(tmpfile.c_str(), std::ios::binary);
+            written = fout.is_open() && saveimage(fout);
+        }
+        if (!written || std::rename(tmpfile.c_str(), imagefile.c_str()) != 0)
+            std::remove(tmpfile.c_str());
+    }
+
+    return err;
 }
 
 bool Library::loadxmldata(const char xmldata[], std::size_t len)
@@ -100,6 +187,389 @@ bool Library::loadxmldata(const char xmldata[], std::size_t len)
 }
 
 Library::Error Library::load(const tinyxml2::XMLDocument &doc)
+{
+    _sources.push_back(std::make_pair(std::string(), 0ULL)); // unknown source, see imageable()
+    const Error err = loadDocument(doc);
+    resolveFunctions();
+    return err;
+}
+
+/**
+ * Binary image of the library configuration. Integers are written as
+ * little endian base 128 varints, signed integers zigzag encoded, so the
+ * image doesn't depend on the host. Containers and strings are prefixed
+ * with their size. The image starts with the seccheck version and the
+ * image format version so images made by other builds are rebuilt.
+ */
+class Library::Image {
+public:
+    static const unsigned int version = 1;
+
+    Image(const char *data, std::size_t size) : pos(data), end(data + size) {}
+
+    bool atEnd() const {
+        return pos == end;
+    }
+
+    static std::string magic() {
+        return std::string("seccheck library image ") + CPPCHECK_VERSION_STRING;
+    }
+
+    static void write(std::ostream &ostr, unsigned long long value) {
+        char buf[10];
+        int len = 0;
+        while (value >= 0x80) {
+            buf[len++] = (char)(value | 0x80);
+            value >>= 7;
+        }
+        buf[len++] = (char)value;
+        ostr.write(buf, len);
+    }
+    static void write(std::ostream &ostr, long long value) {
+        write(ostr, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+    }
+    static void write(std::ostream &ostr, int value) {
+        write(ostr, (long long)value);
+    }
+    static void write(std::ostream &ostr, unsigned int value) {
+        write(ostr, (unsigned long long)value);
+    }
+    static void write(std::ostream &ostr, char value) {
+        write(ostr, (long long)value);
+    }
+    static void write(std::ostream &ostr, bool value) {
+        write(ostr, (unsigned long long)(value ? 1 : 0));
+    }
+    static void write(std::ostream &ostr, const std::string &str) {
+        write(ostr, (unsigned long long)str.size());
+        ostr.write(str.data(), str.size());
+    }
+    template<class T1, class T2>
+    static void write(std::ostream &ostr, const std::pair<T1, T2> &p) {
+        write(ostr, p.first);
+        write(ostr, p.second);
+    }
+    template<class C>
+    static void writeContainer(std::ostream &ostr, const C &c) {
+        write(ostr, (unsigned long long)c.size());
+        for (typename C::const_iterator it = c.begin(); it != c.end(); ++it)
+            write(ostr, *it);
+    }
+    template<class T>
+    static void write(std::ostream &ostr, const std::set<T> &c) {
+        writeContainer(ostr, c);
+    }
+    template<class T>
+    static void write(std::ostream &ostr, const std::vector<T> &c) {
+        writeContainer(ostr, c);
+    }
+    template<class T>
+    static void write(std::ostream &ostr, const std::list<T> &c) {
+        writeContainer(ostr, c);
+    }
+    template<class K, class V>
+    static void write(std::ostream &ostr, const std::map<K, V> &c) {
+        writeContainer(ostr, c);
+    }
+    static void write(std::ostream &ostr, const ArgumentChecks::MinSize &minsize) {
+        write(ostr, (int)minsize.type);
+        write(ostr, minsize.arg);
+        write(ostr, minsize.arg2);
+    }
+    static void write(std::ostream &ostr, const ArgumentChecks &ac) {
+        write(ostr, ac.notbool);
+        write(ostr, ac.notnull);
+        write(ostr, ac.notuninit);
+        write(ostr, ac.formatstr);
+        write(ostr, ac.strz);
+        write(ostr, ac.valid);
+        write(ostr, ac.minsizes);
+    }
+    static void write(std::ostream &ostr, const CodeBlock &block) {
+        write(ostr, block.start());
+        write(ostr, block.end());
+        write(ostr, block.offset());
+        write(ostr, block.blocks());
+    }
+    static void write(std::ostream &ostr, const ExportedFunctions &exporter) {
+        write(ostr, exporter.prefixes());
+        write(ostr, exporter.suffixes());
+    }
+    static void write(std::ostream &ostr, const PodType &podtype) {
+        write(ostr, podtype.size);
+        write(ostr, podtype.sign);
+    }
+    static void write(std::ostream &ostr, const PlatformType &type) {
+        write(ostr, type._type);
+        write(ostr, type._signed);
+        write(ostr, type._unsigned);
+        write(ostr, type._long);
+        write(ostr, type._pointer);
+        write(ostr, type._ptr_ptr);
+        write(ostr, type._const_ptr);
+    }
+    static void write(std::ostream &ostr, const Platform &platform) {
+        write(ostr, platform._platform_types);
+    }
+
+    bool read(unsigned long long &value) {
+        value = 0;
+        for (int shift = 0; pos != end && shift < 64; shift += 7) {
+            const unsigned char c = (unsigned char)*pos++;
+            value |= (unsigned long long)(c & 0x7f) << shift;
+            if (!(c & 0x80))
+                return true;
+        }
+        return false;
+    }
+    bool read(long long &value) {
+        unsigned long long v;
+        if (!read(v))
+            return false;
+        value = (long long)(v >> 1) ^ -(long long)(v & 1);
+        return true;
+    }
+    bool read(int &value) {
+        long long v;
+        if (!read(v))
+            return false;
+        value = (int)v;
+        return true;
+    }
+    bool read(unsigned int &value) {
+        unsigned long long v;
+        if (!read(v))
+            return false;
+        value = (unsigned int)v;
+        return true;
+    }
+    bool read(char &value) {
+        long long v;
+        if (!read(v))
+            return false;
+        value = (char)v;
+        return true;
+    }
+    bool read(bool &value) {
+        unsigned long long v;
+        if (!read(v))
+            return false;
+        value = (v != 0);
+        return true;
+    }
+    bool read(std::string &str) {
+        unsigned long long size;
+        if (!read(size) || size > (unsigned long long)(end - pos))
+            return false;
+        str.assign(pos, (std::size_t)size);
+        pos += size;
+        return true;
+    }
+    template<class T1, class T2>
+    bool read(std::pair<T1, T2> &p) {
+        return read(p.first) && read(p.second);
+    }
+    template<class T>
+    bool read(std::set<T> &c) {
+        unsigned long long size;
+        if (!read(size))
+            return false;
+        c.clear();
+        for (unsigned long long i = 0; i < size; ++i) {
+            T value;
+            if (!read(value))
+                return false;
+            c.insert(c.end(), value);
+        }
+        return true;
+    }
+    template<class T>
+    bool read(std::vector<T> &c) {
+        unsigned long long size;
+        if (!read(size))
+            return false;
+        c.clear();
+        for (unsigned long long i = 0; i < size; ++i) {
+            c.push_back(T());
+            if (!read(c.back()))
+                return false;
+        }
+        return true;
+    }
+    template<class K, class V>
+    bool read(std::map<K, V> &c) {
+        unsigned long long size;
+        if (!read(size))
+            return false;
+        c.clear();
+        for (unsigned long long i = 0; i < size; ++i) {
+            K key;
+            if (!read(key))
+                return false;
+            // the keys were written in order
+            typename std::map<K, V>::iterator it = c.insert(c.end(), std::make_pair(key, V()));
+            if (!read(it->second))
+                return false;
+        }
+        return true;
+    }
+    bool read(std::list<ArgumentChecks::MinSize> &minsizes) {
+        unsigned long long size;
+        if (!read(size))
+            return false;
+        minsizes.clear();
+        for (unsigned long long i = 0; i < size; ++i) {
+            int type;
+            if (!read(type) || type < ArgumentChecks::MinSize::NONE || type > ArgumentChecks::MinSize::MUL)
+                return false;
+            minsizes.push_back(ArgumentChecks::MinSize((ArgumentChecks::MinSize::Type)type, 0));
+            if (!read(minsizes.back().arg) || !read(minsizes.back().arg2))
+                return false;
+        }
+        return true;
+    }
+    bool read(ArgumentChecks &ac) {
+        return read(ac.notbool) &&
+               read(ac.notnull) &&
+               read(ac.notuninit) &&
+               read(ac.formatstr) &&
+               read(ac.strz) &&
+               read(ac.valid) &&
+               read(ac.minsizes);
+    }
+    bool read(CodeBlock &block) {
+        std::string blockStart, blockEnd;
+        int offset;
+        std::set<std::string> blocks;
+        if (!read(blockStart) || !read(blockEnd) || !read(offset) || !read(blocks))
+            return false;
+        block.setStart(blockStart);
+        block.setEnd(blockEnd);
+        block.setOffset(offset);
+        for (std::set<std::string>::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+            block.addBlock(*it);
+        return true;
+    }
+    bool read(ExportedFunctions &exporter) {
+        std::set<std::string> prefixes, suffixes;
+        if (!read(prefixes) || !read(suffixes))
+            return false;
+        for (std::set<std::string>::const_iterator it = prefixes.begin(); it != prefixes.end(); ++it)
+            exporter.addPrefix(*it);
+        for (std::set<std::string>::const_iterator it = suffixes.begin(); it != suffixes.end(); ++it)
+            exporter.addSuffix(*it);
+        return true;
+    }
+    bool read(PodType &podtype) {
+        return read(podtype.size) && read(podtype.sign);
+    }
+    bool read(PlatformType &type) {
+        return read(type._type) &&
+               read(type._signed) &&
+               read(type._unsigned) &&
+               read(type._long) &&
+               read(type._pointer) &&
+               read(type._ptr_ptr) &&
+               read(type._const_ptr);
+    }
+    bool read(Platform &platform) {
+        return read(platform._platform_types);
+    }
+
+private:
+    const char *pos;
+    const char *end;
+};
+
+bool Library::saveimage(std::ostream &ostr) const
+{
+    Image::write(ostr, Image::magic());
+    Image::write(ostr, Image::version);
+    Image::write(ostr, _sources);
+    Image::write(ostr, use);
+    Image::write(ostr, leakignore);
+    Image::write(ostr, functionconst);
+    Image::write(ostr, functionpure);
+    Image::write(ostr, useretval);
+    Image::write(ostr, argumentChecks);
+    Image::write(ostr, returnuninitdata);
+    Image::write(ostr, defines);
+    Image::write(ostr, allocid);
+    Image::write(ostr, _files);
+    Image::write(ostr, _alloc);
+    Image::write(ostr, _dealloc);
+    Image::write(ostr, _noreturn);
+    Image::write(ostr, _ignorefunction);
+    Image::write(ostr, _reporterrors);
+    Image::write(ostr, _processAfterCode);
+    Image::write(ostr, _markupExtensions);
+    Image::write(ostr, _keywords);
+    Image::write(ostr, _executableblocks);
+    Image::write(ostr, _exporters);
+    Image::write(ostr, _importers);
+    Image::write(ostr, _reflection);
+    Image::write(ostr, _formatstr);
+    Image::write(ostr, podtypes);
+    Image::write(ostr, platform_types);
+    Image::write(ostr, platforms);
+    return ostr.good();
+}
+
+bool Library::loadimage(std::istream &istr)
+{
+    std::ostringstream data;
+    data << istr.rdbuf();
+    const std::string &str = data.str();
+    return loadimage(str.data(), str.size());
+}
+
+bool Library::loadimage(const char data[], std::size_t size)
+{
+    Image in(data, size);
+    std::string magic;
+    unsigned int version = 0;
+    if (!in.read(magic) || magic != Image::magic() ||
+        !in.read(version) || version != Image::version)
+        return false;
+
+    Library image;
+    if (!in.read(image._sources) ||
+        !in.read(image.use) ||
+        !in.read(image.leakignore) ||
+        !in.read(image.functionconst) ||
+        !in.read(image.functionpure) ||
+        !in.read(image.useretval) ||
+        !in.read(image.argumentChecks) ||
+        !in.read(image.returnuninitdata) ||
+        !in.read(image.defines) ||
+        !in.read(image.allocid) ||
+        !in.read(image._files) ||
+        !in.read(image._alloc) ||
+        !in.read(image._dealloc) ||
+        !in.read(image._noreturn) ||
+        !in.read(image._ignorefunction) ||
+        !in.read(image._reporterrors) ||
+        !in.read(image._processAfterCode) ||
+        !in.read(image._markupExtensions) ||
+        !in.read(image._keywords) ||
+        !in.read(image._executableblocks) ||
+        !in.read(image._exporters) ||
+        !in.read(image._importers) ||
+        !in.read(image._reflection) ||
+        !in.read(image._formatstr) ||
+        !in.read(image.podtypes) ||
+        !in.read(image.platform_types) ||
+        !in.read(image.platforms) ||
+        !in.atEnd())
+        return false;
+
+    image.resolveFunctions();
+    image._cachedir = _cachedir;
+    *this = std::move(image);
+    return true;
+}
+
+Library::Error Library::loadDocument(const tinyxml2::XMLDocument &doc)
 {
     const tinyxml2::XMLElement * const rootnode = doc.FirstChildElement();
 
@@ -462,45 +932,106 @@ Library::Error Library::load(const tinyxml2::XMLDocument &doc)
     return Error(OK);
 }
 
-bool Library::isargvalid(const std::string &functionName, int argnr, const MathLib::bigint argvalue) const
+// Parse a validation expression such as "1:5,8,10:" into ranges
+static std::vector<std::pair<MathLib::bigint, MathLib::bigint> > validRanges(const std::string &valid)
 {
-    const ArgumentChecks *ac = getarg(functionName, argnr);
-    if (!ac || ac->valid.empty())
-        return true;
-    TokenList tokenList(0);
-    std::istringstream istr(ac->valid + ',');
-    tokenList.createTokens(istr);
-    for (Token *tok = tokenList.front(); tok; tok = tok->next()) {
-        if (Token::Match(tok,"- %num%")) {
-            tok->str("-" + tok->strAt(1));
-            tok->deleteNext();
+    std::vector<std::pair<MathLib::bigint, MathLib::bigint> > ranges;
+    std::string::size_type start = 0;
+    while (start < valid.size()) {
+        std::string::size_type end = valid.find(',', start);
+        if (end == std::string::npos)
+            end = valid.size();
+        const std::string item = valid.substr(start, end - start);
+        start = end + 1;
+
+        const std::string::size_type colon = item.find(':');
+        if (colon == std::string::npos) {
+            if (!item.empty()) {
+                const MathLib::bigint value = MathLib::toLongNumber(item);
+                ranges.push_back(std::make_pair(value, value));
+            }
+        } else if (item.size() > 1U) {
+            const MathLib::bigint low = (colon == 0) ? std::numeric_limits<MathLib::bigint>::min() : MathLib::toLongNumber(item.substr(0, colon));
+            const MathLib::bigint high = (colon + 1 == item.size()) ? std::numeric_limits<MathLib::bigint>::max() : MathLib::toLongNumber(item.substr(colon + 1));
+            ranges.push_back(std::make_pair(low, high));
         }
     }
-    for (const Token *tok = tokenList.front(); tok; tok = tok->next()) {
-        if (tok->isNumber() && argvalue == MathLib::toLongNumber(tok->str()))
-            return true;
-        if (Token::Match(tok, "%num% : %num%") && argvalue >= MathLib::toLongNumber(tok->str()) && argvalue <= MathLib::toLongNumber(tok->strAt(2)))
-            return true;
-        if (Token::Match(tok, "%num% : ,") && argvalue >= MathLib::toLongNumber(tok->str()))
-            return true;
-        if ((!tok->previous() || tok->previous()->str() == ",") && Token::Match(tok,": %num%") && argvalue <= MathLib::toLongNumber(tok->strAt(1)))
+    return ranges;
+}
+
+bool Library::FunctionDescriptor::isargvalid(int argnr, const MathLib::bigint argvalue) const
+{
+    const ArgumentChecks *ac = arg(argnr);
+    if (!ac || ac->valid.empty())
+        return true;
+    for (auto it = ac->validranges.cbegin(); it != ac->validranges.cend(); ++it) {
+        if (argvalue >= it->first && argvalue <= it->second)
             return true;
     }
     return false;
 }
 
-const Library::ArgumentChecks * Library::getarg(const std::string &functionName, int argnr) const
+Library::FunctionDescriptor &Library::resolveFunction(const std::string &functionName)
 {
-    auto it1 = argumentChecks.find(functionName);
-    if (it1 == argumentChecks.end())
-        return nullptr;
-    auto it2 = it1->second.find(argnr);
-    if (it2 != it1->second.end())
-        return &it2->second;
-    auto it3 = it1->second.find(-1);
-    if (it3 != it1->second.end())
-        return &it3->second;
-    return nullptr;
+    const auto it = _functionIds.find(functionName);
+    if (it != _functionIds.end())
+        return _functions[it->second];
+    const unsigned int id = static_cast<unsigned int>(_functions.size());
+    _functionIds[functionName] = id;
+    _functions.push_back(FunctionDescriptor());
+    _functions.back().id = id;
+    return _functions.back();
+}
+
+void Library::resolveFunctions()
+{
+    _functionIds.clear();
+    _functions.clear();
+
+    for (auto it = _noreturn.cbegin(); it != _noreturn.cend(); ++it) {
+        FunctionDescriptor &f = resolveFunction(it->first);
+        f.noreturn = it->second;
+        f.notnoreturn = !it->second;
+    }
+
+    for (auto it = _ignorefunction.cbegin(); it != _ignorefunction.cend(); ++it)
+        resolveFunction(*it).ignore = true;
+
+    for (auto it = _formatstr.cbegin(); it != _formatstr.cend(); ++it) {
+        FunctionDescriptor &f = resolveFunction(it->first);
+        f.formatstr = true;
+        f.formatstr_scan = it->second.first;
+        f.formatstr_secure = it->second.second;
+    }
+
+    for (auto it = argumentChecks.cbegin(); it != argumentChecks.cend(); ++it) {
+        FunctionDescriptor &f = resolveFunction(it->first);
+        bool formatstrarg = false;
+        for (auto arg = it->second.cbegin(); arg != it->second.cend(); ++arg) {
+            ArgumentChecks *ac;
+            if (arg->first >= 0) {
+                if (arg->first >= (int)f._args.size()) {
+                    f._args.resize(arg->first + 1);
+                    f._hasArg.resize(arg->first + 1, false);
+                }
+                f._hasArg[arg->first] = true;
+                ac = &f._args[arg->first];
+            } else if (arg->first == -1) {
+                f._hasAnyArg = true;
+                ac = &f._anyArg;
+            } else
+                continue;
+
+            *ac = arg->second;
+            ac->validranges = validRanges(ac->valid);
+            if (!ac->minsizes.empty())
+                f.hasminsize = true;
+            if (ac->formatstr && !formatstrarg) {
+                formatstrarg = true;
+                f.formatstrargnr = arg->first;
+            }
+        }
+    }
 }
 
 bool Library::isScopeNoReturn(const Token *end, std::string *unknownFunc) const
@@ -26,10 +26,13 @@
 #include "mathlib.h"
 #include "token.h"
 
+#include <iosfwd>
 #include <map>
 #include <set>
 #include <string>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 class TokenList;
 namespace tinyxml2 {
@@ -63,6 +66,26 @@ public:
     /** this is primarily meant for unit tests. it only returns true/false */
     bool loadxmldata(const char xmldata[], std::size_t len);
 
+    /**
+     * Keep binary images of the loaded configuration in this directory.
+     * load() then reads the image instead of the XML file if the image
+     * was made from the same files with the same contents.
+     */
+    void setcachedir(const std::string &dir) {
+        _cachedir = dir;
+    }
+
+    const std::string &cachedir() const {
+        return _cachedir;
+    }
+
+    /** write the whole configuration as a binary image */
+    bool saveimage(std::ostream &ostr) const;
+
+    /** replace the configuration with a binary image written by saveimage() of this seccheck version */
+    bool loadimage(std::istream &istr);
+    bool loadimage(const char data[], std::size_t size);
+
     /** get allocation id for function by name */
     int alloc(const char name[]) const {
         return getid(_alloc, name);
@@ -95,6 +118,7 @@ public:
     /** add noreturn function setting */
     void setnoreturn(const std::string& funcname, bool noreturn) {
         _noreturn[funcname] = noreturn;
+        resolveFunctions();
     }
 
     /** is allocation type memory? */
@@ -108,15 +132,18 @@ public:
     }
 
     bool formatstr_function(const std::string& funcname) const {
-        return _formatstr.find(funcname) != _formatstr.end();
+        const FunctionDescriptor *f = descriptor(funcname);
+        return f && f->formatstr;
     }
 
     bool formatstr_scan(const std::string& funcname) const {
-        return _formatstr.at(funcname).first;
+        const FunctionDescriptor *f = descriptor(funcname);
+        return f && f->formatstr_scan;
     }
 
     bool formatstr_secure(const std::string& funcname) const {
-        return _formatstr.at(funcname).second;
+        const FunctionDescriptor *f = descriptor(funcname);
+        return f && f->formatstr_secure;
     }
 
     std::set<std::string> use;
@@ -126,13 +153,13 @@ public:
     std::set<std::string> useretval;
 
     bool isnoreturn(const std::string &name) const {
-        auto it = _noreturn.find(name);
-        return (it != _noreturn.end() && it->second);
+        const FunctionDescriptor *f = descriptor(name);
+        return f && f->noreturn;
     }
 
     bool isnotnoreturn(const std::string &name) const {
-        auto it = _noreturn.find(name);
-        return (it != _noreturn.end() && !it->second);
+        const FunctionDescriptor *f = descriptor(name);
+        return f && f->notnoreturn;
     }
 
     bool isScopeNoReturn(const Token *end, std::string *unknownFunc) const;
@@ -154,6 +181,9 @@ public:
         bool         strz;
         std::string  valid;
 
+        /** the ranges in 'valid', parsed by resolveFunctions() */
+        std::vector<std::pair<MathLib::bigint, MathLib::bigint> > validranges;
+
         class MinSize {
         public:
             enum Type {NONE,STRLEN,ARGVALUE,SIZEOF,MUL};
@@ -168,53 +198,145 @@ public:
     // function name, argument nr => argument data
     std::map<std::string, std::map<int, ArgumentChecks> > argumentChecks;
 
+    /**
+     * @brief Library configuration of a function, resolved from the
+     * string-keyed maps. Look it up once per function call with
+     * descriptor() and query it for each argument.
+     */
+    class FunctionDescriptor {
+    public:
+        FunctionDescriptor() :
+            id(0),
+            noreturn(false),
+            notnoreturn(false),
+            ignore(false),
+            formatstr(false),
+            formatstr_scan(false),
+            formatstr_secure(false),
+            formatstrargnr(0),
+            hasminsize(false),
+            _hasAnyArg(false) {
+        }
+
+        /** interned id of the function name */
+        unsigned int id;
+
+        bool noreturn;
+        bool notnoreturn;
+        bool ignore;
+        bool formatstr;
+        bool formatstr_scan;
+        bool formatstr_secure;
+
+        /** first argument that is a format string, 0 if there is none */
+        int formatstrargnr;
+
+        bool hasminsize;
+
+        const ArgumentChecks *arg(int argnr) const {
+            if (argnr >= 0 && argnr < (int)_hasArg.size() && _hasArg[argnr])
+                return &_args[argnr];
+            return _hasAnyArg ? &_anyArg : nullptr;
+        }
+
+        bool isboolargbad(int argnr) const {
+            const ArgumentChecks *a = arg(argnr);
+            return a && a->notbool;
+        }
+
+        bool isnullargbad(int argnr) const {
+            const ArgumentChecks *a = arg(argnr);
+            return a && a->notnull;
+        }
+
+        bool isuninitargbad(int argnr) const {
+            const ArgumentChecks *a = arg(argnr);
+            return a && a->notuninit;
+        }
+
+        bool isargformatstr(int argnr) const {
+            const ArgumentChecks *a = arg(argnr);
+            return a && a->formatstr;
+        }
+
+        bool isargstrz(int argnr) const {
+            const ArgumentChecks *a = arg(argnr);
+            return a && a->strz;
+        }
+
+        bool isargvalid(int argnr, const MathLib::bigint argvalue) const;
+
+        const std::string& validarg(int argnr) const {
+            const ArgumentChecks *a = arg(argnr);
+            return a ? a->valid : emptyString;
+        }
+
+        const std::list<ArgumentChecks::MinSize> *argminsizes(int argnr) const {
+            const ArgumentChecks *a = arg(argnr);
+            return a ? &a->minsizes : nullptr;
+        }
+
+    private:
+        friend class Library;
+
+        std::vector<ArgumentChecks> _args; // by argument nr
+        std::vector<bool> _hasArg;
+        ArgumentChecks _anyArg;
+        bool _hasAnyArg;
+    };
+
+    /** get the library configuration of a function, nullptr if the library doesn't know it */
+    const FunctionDescriptor *descriptor(const std::string &functionName) const {
+        const auto it = _functionIds.find(functionName);
+        return (it != _functionIds.end()) ? &_functions[it->second] : nullptr;
+    }
+
+    /** build the function descriptors again, needed after argumentChecks is changed directly */
+    void resolveFunctions();
+
     bool isboolargbad(const std::string &functionName, int argnr) const {
-        const ArgumentChecks *arg = getarg(functionName, argnr);
-        return arg && arg->notbool;
+        const FunctionDescriptor *f = descriptor(functionName);
+        return f && f->isboolargbad(argnr);
     }
 
     bool isnullargbad(const std::string &functionName, int argnr) const {
-        const ArgumentChecks *arg = getarg(functionName, argnr);
-        return arg && arg->notnull;
+        const FunctionDescriptor *f = descriptor(functionName);
+        return f && f->isnullargbad(argnr);
     }
 
     bool isuninitargbad(const std::string &functionName, int argnr) const {
-        const ArgumentChecks *arg = getarg(functionName, argnr);
-        return arg && arg->notuninit;
+        const FunctionDescriptor *f = descriptor(functionName);
+        return f && f->isuninitargbad(argnr);
     }
 
     bool isargformatstr(const std::string &functionName, int argnr) const {
-        const ArgumentChecks *arg = getarg(functionName, argnr);
-        return arg && arg->formatstr;
+        const FunctionDescriptor *f = descriptor(functionName);
+        return f && f->isargformatstr(argnr);
     }
 
     bool isargstrz(const std::string &functionName, int argnr) const {
-        const ArgumentChecks *arg = getarg(functionName, argnr);
-        return arg && arg->strz;
+        const FunctionDescriptor *f = descriptor(functionName);
+        return f && f->isargstrz(argnr);
     }
 
-    bool isargvalid(const std::string &functionName, int argnr, const MathLib::bigint argvalue) const;
+    bool isargvalid(const std::string &functionName, int argnr, const MathLib::bigint argvalue) const {
+        const FunctionDescriptor *f = descriptor(functionName);
+        return !f || f->isargvalid(argnr, argvalue);
+    }
 
     const std::string& validarg(const std::string &functionName, int argnr) const {
-        const ArgumentChecks *arg = getarg(functionName, argnr);
-        return arg ? arg->valid : emptyString;
+        const FunctionDescriptor *f = descriptor(functionName);
+        return f ? f->validarg(argnr) : emptyString;
     }
 
     bool hasminsize(const std::string &functionName) const {
-        auto it1 = argumentChecks.find(functionName);
-        if (it1 == argumentChecks.end()) {
-            return false;
-		}
-        for (auto it2 = it1->second.begin(); it2 != it1->second.end(); ++it2) {
-            if (!it2->second.minsizes.empty())
-                return true;
-        }
-        return false;
+        const FunctionDescriptor *f = descriptor(functionName);
+        return f && f->hasminsize;
     }
 
     const std::list<ArgumentChecks::MinSize> *argminsizes(const std::string &functionName, int argnr) const {
-        const ArgumentChecks *arg = getarg(functionName, argnr);
-        return arg ? &arg->minsizes : nullptr;
+        const FunctionDescriptor *f = descriptor(functionName);
+        return f ? f->argminsizes(argnr) : nullptr;
     }
 
     bool markupFile(const std::string &path) const {
@@ -236,12 +358,70 @@ public:
     }
 
     bool ignorefunction(const std::string &function) const {
-        return (_ignorefunction.find(function) != _ignorefunction.end());
+        const FunctionDescriptor *f = descriptor(function);
+        return f && f->ignore;
     }
 
-    bool isexecutableblock(const std::string &file, const std::string &token) const {
+    class CodeBlock {
+    public:
+        CodeBlock() : _offset(0) {}
+
+        void setStart(const std::string& s) {
+            _start = s;
+        }
+        void setEnd(const std::string& e) {
+            _end = e;
+        }
+        void setOffset(const int o) {
+            _offset = o;
+        }
+        void addBlock(const std::string& blockName) {
+            _blocks.insert(blockName);
+        }
+        const std::string& start() const {
+            return _start;
+        }
+        const std::string& end() const {
+            return _end;
+        }
+        int offset() const {
+            return _offset;
+        }
+        bool isBlock(const std::string& blockName) const {
+            return _blocks.find(blockName) != _blocks.end();
+        }
+        const std::set<std::string> &blocks() const {
+            return _blocks;
+        }
+
+    private:
+        std::string _start;
+        std::string _end;
+        int _offset;
+        std::set<std::string> _blocks;
+    };
+
+    /** get the executable code blocks of a markup file, look it up once per file */
+    const CodeBlock *executableblocks(const std::string &file) const {
         const auto it = _executableblocks.find(Path::getFilenameExtensionInLowerCase(file));
-        return (it != _executableblocks.end() && it->second.isBlock(token));
+        return (it != _executableblocks.end()) ? &it->second : nullptr;
+    }
+
+    /** get the keywords of a markup file, look it up once per file */
+    const std::set<std::string> *keywords(const std::string &file) const {
+        const auto it = _keywords.find(Path::getFilenameExtensionInLowerCase(file));
+        return (it != _keywords.end()) ? &it->second : nullptr;
+    }
+
+    /** get the importers of a markup file, look it up once per file */
+    const std::set<std::string> *importers(const std::string &file) const {
+        const auto it = _importers.find(Path::getFilenameExtensionInLowerCase(file));
+        return (it != _importers.end()) ? &it->second : nullptr;
+    }
+
+    bool isexecutableblock(const std::string &file, const std::string &token) const {
+        const CodeBlock *blocks = executableblocks(file);
+        return blocks && blocks->isBlock(token);
     }
 
     int blockstartoffset(const std::string &file) const {
@@ -277,9 +457,8 @@ public:
     }
 
     bool iskeyword(const std::string &file, const std::string &keyword) const {
-        const auto it =
-            _keywords.find(Path::getFilenameExtensionInLowerCase(file));
-        return (it != _keywords.end() && it->second.count(keyword));
+        const std::set<std::string> *words = keywords(file);
+        return (words && words->count(keyword));
     }
 
     bool isexporter(const std::string &prefix) const {
@@ -297,9 +476,8 @@ public:
     }
 
     bool isimporter(const std::string& file, const std::string &importer) const {
-        const auto it =
-            _importers.find(Path::getFilenameExtensionInLowerCase(file));
-        return (it != _importers.end() && it->second.count(importer) > 0);
+        const std::set<std::string> *imports = importers(file);
+        return (imports && imports->count(importer) > 0);
     }
 
     bool isreflection(const std::string &token) const {
@@ -398,48 +576,23 @@ private:
         bool isSuffix(const std::string& suffix) const {
             return (_suffixes.find(suffix) != _suffixes.end());
         }
+        const std::set<std::string> &prefixes() const {
+            return _prefixes;
+        }
+        const std::set<std::string> &suffixes() const {
+            return _suffixes;
+        }
 
     private:
         std::set<std::string> _prefixes;
         std::set<std::string> _suffixes;
     };
-    class CodeBlock {
-    public:
-        CodeBlock() : _offset(0) {}
+    class Image;
 
-        void setStart(const std::string& s) {
-            _start = s;
-        }
-        void setEnd(const std::string& e) {
-            _end = e;
-        }
-        void setOffset(const int o) {
-            _offset = o;
-        }
-        void addBlock(const std::string& blockName) {
-            _blocks.insert(blockName);
-        }
-        const std::string& start() const {
-            return _start;
-        }
-        const std::string& end() const {
-            return _end;
-        }
-        int offset() const {
-            return _offset;
-        }
-        bool isBlock(const std::string& blockName) const {
-            return _blocks.find(blockName) != _blocks.end();
-        }
-
-    private:
-        std::string _start;
-        std::string _end;
-        int _offset;
-        std::set<std::string> _blocks;
-    };
     int allocid;
     std::set<std::string> _files;
+    std::vector<std::pair<std::string, unsigned long long> > _sources; // loaded files and hashes of their contents, in load order
+    std::string _cachedir;
     std::map<std::string, int> _alloc; // allocation functions
     std::map<std::string, int> _dealloc; // deallocation functions
     std::map<std::string, bool> _noreturn; // is function noreturn?
@@ -456,8 +609,11 @@ private:
     std::map<std::string, struct PodType> podtypes; // pod types
     std::map<std::string, PlatformType> platform_types; // platform independent typedefs
     std::map<std::string, Platform> platforms; // platform dependent typedefs
+    std::unordered_map<std::string, unsigned int> _functionIds; // interned function names
+    std::vector<FunctionDescriptor> _functions; // function descriptors by id
 
-    const ArgumentChecks * getarg(const std::string &functionName, int argnr) const;
+    Error loadDocument(const tinyxml2::XMLDocument &doc);
+    FunctionDescriptor &resolveFunction(const std::string &functionName);
 
     static int getid(const std::map<std::string,int> &data, const std::string &name) {
         const auto it = data.find(name);
@@ -42,6 +42,10 @@ Settings::Settings()
       _exitCode(0),
       _showtime(SHOWTIME_NONE),
       _maxConfigs(12),
+      maxTemplateInstantiations(0),
+      valueFlowMaxValues(0),
+      valueFlowMaxSteps(0),
+      checkThreads(1),
       enforcedLang(None),
       reportProgress(false),
       checkConfiguration(false),
@@ -146,6 +146,23 @@ public:
         Default is 12. (--max-configs=N) */
     unsigned int _maxConfigs;
 
+    /** @brief Maximum number of template instantiations per translation unit.
+        Default is 0 which means no limit. (--max-template-instantiations=N) */
+    unsigned int maxTemplateInstantiations;
+
+    /** @brief Maximum number of values per token in the value flow analysis.
+        Default is 0 which means no limit. (--valueflow-max-values=N) */
+    unsigned int valueFlowMaxValues;
+
+    /** @brief Maximum number of forward steps per function in the value flow
+        analysis. Default is 0 which means no limit. (--valueflow-max-steps=N) */
+    unsigned int valueFlowMaxSteps;
+
+    /** @brief Number of threads that run the checks of one translation unit
+        concurrently. Default is 1 which means the checks are run serially.
+        (--check-threads=N) */
+    unsigned int checkThreads;
+
     /**
      * @brief Returns true if given id is in the list of
      * enabled extra checks (--enable)
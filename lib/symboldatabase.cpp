@@ -32,7 +32,7 @@
 //---------------------------------------------------------------------------
 
 SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
-    : _tokenizer(tokenizer), _settings(settings), _errorLogger(errorLogger)
+    : _tokenizer(tokenizer), _settings(settings), _errorLogger(errorLogger), _functionCallTokensCreated(false)
 {
     // create global scope
     scopeList.push_back(Scope(this, nullptr, nullptr));
@@ -121,9 +121,7 @@ SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *setti
                 if (new_scope->isClassOrStruct() || new_scope->type == Scope::eUnion) {
                     Type* new_type = findType(tok->next(), scope);
                     if (!new_type) {
-                        typeList.push_back(Type(new_scope->classDef, new_scope, scope));
-                        new_type = &typeList.back();
-                        scope->definedTypes.push_back(new_type);
+                        new_type = addType(Type(new_scope->classDef, new_scope, scope), scope);
                     } else
                         new_type->classScope = new_scope;
                     new_scope->definedType = new_type;
@@ -189,8 +187,7 @@ SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *setti
                  tok->strAt(-1) != "friend") {
             if (!findType(tok->next(), scope)) {
                 // fill typeList..
-                typeList.push_back(Type(tok, 0, scope));
-                scope->definedTypes.push_back(&typeList.back());
+                addType(Type(tok, 0, scope), scope);
             }
             tok = tok->tokAt(2);
         }
@@ -230,9 +227,7 @@ SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *setti
                 varNameTok = varNameTok->next();
             }
 
-            typeList.push_back(Type(tok, new_scope, scope));
-            new_scope->definedType = &typeList.back();
-            scope->definedTypes.push_back(&typeList.back());
+            new_scope->definedType = addType(Type(tok, new_scope, scope), scope);
 
             scope->addVariable(varNameTok, tok, tok, access[scope], new_scope->definedType, scope);
 
@@ -268,9 +263,7 @@ SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *setti
             new_scope->classStart = tok2;
             new_scope->classEnd = tok2->link();
 
-            typeList.push_back(Type(tok, new_scope, scope));
-            new_scope->definedType = &typeList.back();
-            scope->definedTypes.push_back(&typeList.back());
+            new_scope->definedType = addType(Type(tok, new_scope, scope), scope);
 
             // make sure we have valid code
             if (!new_scope->classEnd) {
@@ -1068,7 +1061,7 @@ SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *setti
     }
 
     // Set scope pointers
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (std::deque<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         Token* start = const_cast<Token*>(it->classStart);
         Token* end = const_cast<Token*>(it->classEnd);
         if (it->type == Scope::eGlobal) {
@@ -1083,7 +1076,7 @@ SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *setti
             for (Token* tok = start->next(); tok != end; tok = tok->next()) {
                 if (tok->str() == "{") {
                     bool break2 = false;
-                    for (std::list<Scope*>::const_iterator innerScope = it->nestedList.begin(); innerScope != it->nestedList.end(); ++innerScope) {
+                    for (std::vector<Scope*>::const_iterator innerScope = it->nestedList.begin(); innerScope != it->nestedList.end(); ++innerScope) {
                         if (tok == (*innerScope)->classStart) { // Is begin of inner scope
                             tok = tok->link();
                             if (!tok || tok->next() == end || !tok->next()) {
@@ -1103,8 +1096,8 @@ SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *setti
     }
 
     // Set function definition and declaration pointers
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-        for (std::list<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
+    for (std::deque<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        for (std::deque<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
             if (func->tokenDef)
                 const_cast<Token *>(func->tokenDef)->function(&*func);
 
@@ -1122,8 +1115,8 @@ SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *setti
     }
 
     // Set C++ 11 delegate constructor function call pointers
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-        for (std::list<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
+    for (std::deque<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        for (std::deque<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
             // look for initializer list
             if (func->type == Function::eConstructor && func->functionScope &&
                 func->functionScope->functionOf && func->arg && func->arg->link()->strAt(1) == ":") {
@@ -2789,10 +2782,9 @@ const Token *Scope::checkVariable(const Token *tok, AccessControl varaccess)
 
 const Variable *Scope::getVariable(const std::string &varname) const
 {
-    for (auto iter = varlist.begin(); iter != varlist.end(); ++iter) {
-        if (iter->name() == varname)
-            return &*iter;
-    }
+    const auto it = varMap.find(varname);
+    if (it != varMap.end())
+        return it->second;
 
     return nullptr;
 }
@@ -2874,35 +2866,48 @@ bool Scope::isVariableDeclaration(const Token* tok, const Token*& vartok, const
 
 //---------------------------------------------------------------------------
 
+Type *SymbolDatabase::addType(const Type &type, Scope *scope)
+{
+    typeList.push_back(type);
+    Type * const back = &typeList.back();
+    scope->addDefinedType(back);
+    _typesByName[back->name()].push_back(back);
+    return back;
+}
+
 const Type* SymbolDatabase::findVariableType(const Scope *start, const Token *typeTok) const
 {
-    for (auto type = typeList.begin(); type != typeList.end(); ++type) {
-        // do the names match?
-        if (type->name() == typeTok->str()) {
-            // check if type does not have a namespace
-            if (typeTok->strAt(-1) != "::") {
-                const Scope *parent = start;
+    // types with matching names
+    const auto types = _typesByName.find(typeTok->str());
+    if (types == _typesByName.end())
+        return nullptr;
 
-                // check if in same namespace
-                while (parent) {
-                    // out of line class function belongs to class
-                    if (parent->type == Scope::eFunction && parent->functionOf)
-                        parent = parent->functionOf;
-                    else if (parent != type->enclosingScope)
-                        parent = parent->nestedIn;
-                    else
-                        break;
-                }
+    for (auto it = types->second.begin(); it != types->second.end(); ++it) {
+        const Type * const type = *it;
 
-                if (type->enclosingScope == parent)
-                    return &(*type);
-            }
+        // check if type does not have a namespace
+        if (typeTok->strAt(-1) != "::") {
+            const Scope *parent = start;
 
-            // type has a namespace
-            else {
-                // FIXME check if namespace path matches supplied path
-                return &(*type);
+            // check if in same namespace
+            while (parent) {
+                // out of line class function belongs to class
+                if (parent->type == Scope::eFunction && parent->functionOf)
+                    parent = parent->functionOf;
+                else if (parent != type->enclosingScope)
+                    parent = parent->nestedIn;
+                else
+                    break;
             }
+
+            if (type->enclosingScope == parent)
+                return type;
+        }
+
+        // type has a namespace
+        else {
+            // FIXME check if namespace path matches supplied path
+            return type;
         }
     }
 
@@ -3179,6 +3184,23 @@ const Function* SymbolDatabase::findFunction(const Token *tok) const
 
 //---------------------------------------------------------------------------
 
+const std::vector<const Token *> &SymbolDatabase::functionCallTokens() const
+{
+    if (!_functionCallTokensCreated) {
+        _functionCallTokensCreated = true;
+        for (std::size_t i = 0; i < functionScopes.size(); ++i) {
+            const Scope *scope = functionScopes[i];
+            for (const Token *tok = scope->classStart; tok != scope->classEnd; tok = tok->next()) {
+                if (tok->isName() && tok->varId() == 0 && tok->strAt(1) == "(")
+                    _functionCallTokens.push_back(tok);
+            }
+        }
+    }
+    return _functionCallTokens;
+}
+
+//---------------------------------------------------------------------------
+
 const Scope *SymbolDatabase::findScopeByName(const std::string& name) const
 {
     for (auto it = scopeList.begin(); it != scopeList.end(); ++it) {
@@ -3214,10 +3236,9 @@ const Scope *Scope::findRecordInNestedList(const std::string & name) const
 
 const Type* Scope::findType(const std::string & name) const
 {
-    for (auto it = definedTypes.begin(); it != definedTypes.end(); ++it) {
-        if ((*it)->name() == name)
-            return (*it);
-    }
+    const auto it = definedTypesMap.find(name);
+    if (it != definedTypesMap.end())
+        return it->second;
     return 0;
 }
 
@@ -23,10 +23,12 @@
 
 #include <string>
 #include <list>
+#include <deque>
 #include <vector>
 #include <set>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
 
 #include "config.h"
 #include "token.h"
@@ -646,7 +648,7 @@ public:
     const ::Type *retType; // function return type
     const Scope *functionScope; // scope of function body
     const Scope* nestedIn; // Scope the function is declared in
-    std::list<Variable> argumentList; // argument list
+    std::deque<Variable> argumentList; // argument list
     unsigned int initArgCount; // number of args with default values
     Type type;             // constructor, destructor, ...
     AccessControl access;  // public/protected/private
@@ -692,17 +694,19 @@ public:
     const Token *classDef;   // class/struct/union/namespace token
     const Token *classStart; // '{' token
     const Token *classEnd;   // '}' token
-    std::list<Function> functionList;
+    std::deque<Function> functionList;
     std::multimap<std::string, const Function *> functionMap;
-    std::list<Variable> varlist;
+    std::deque<Variable> varlist;
     const Scope *nestedIn;
-    std::list<Scope *> nestedList;
+    std::vector<Scope *> nestedList;
     unsigned int numConstructors;
     unsigned int numCopyOrMoveConstructors;
     std::list<UsingInfo> usingList;
     ScopeType type;
     Type* definedType;
-    std::list<Type*> definedTypes;
+    std::vector<Type*> definedTypes;
+    std::unordered_map<std::string, Type *> definedTypesMap;
+    std::unordered_map<std::string, const Variable *> varMap;
 
     // function specific fields
     const Scope *functionOf; // scope this function belongs to
@@ -758,6 +762,16 @@ public:
         varlist.push_back(Variable(token_, start_, end_, varlist.size(),
                                    access_,
                                    type_, scope_));
+
+        const Variable * back = &varlist.back();
+
+        varMap.insert(std::make_pair(back->name(), back));
+    }
+
+    void addDefinedType(Type *type_) {
+        definedTypes.push_back(type_);
+
+        definedTypesMap.insert(std::make_pair(type_->name(), type_));
     }
 
     /** @brief initialize varlist */
@@ -819,7 +833,7 @@ public:
     ~SymbolDatabase();
 
     /** @brief Information about all namespaces/classes/structrues */
-    std::list<Scope> scopeList;
+    std::deque<Scope> scopeList;
 
     /** @brief Fast access to function scopes */
     std::vector<const Scope *> functionScopes;
@@ -828,7 +842,7 @@ public:
     std::vector<const Scope *> classAndStructScopes;
 
     /** @brief Fast access to types */
-    std::list<Type> typeList;
+    std::deque<Type> typeList;
 
     /**
      * @brief find a variable type if it's a user defined type
@@ -858,10 +872,7 @@ public:
     }
 
     bool isClassOrStruct(const std::string &type) const {
-        for (auto i = typeList.begin(); i != typeList.end(); ++i)
-            if (i->name() == type)
-                return true;
-        return false;
+        return _typesByName.find(type) != _typesByName.end();
     }
 
     const Variable *getVariableFromVarId(std::size_t varId) const {
@@ -872,6 +883,14 @@ public:
         return _variableList.size();
     }
 
+    /**
+     * @brief Possible function calls in the function scopes: name tokens
+     * without varid that are followed by "(". The tokens are in the order
+     * of the function scopes and then in token order. The list is created
+     * when it is first used, so the checks get tokens of the final token list.
+     */
+    const std::vector<const Token *> &functionCallTokens() const;
+
     /**
      * @brief output a debug message
      */
@@ -891,6 +910,7 @@ private:
     Function *addGlobalFunction(Scope*& scope, const Token*& tok, const Token *argStart, const Token* funcStart);
     void addNewFunction(Scope **info, const Token **tok);
     static bool isFunction(const Token *tok, const Scope* outerScope, const Token **funcStart, const Token **argStart);
+    Type *addType(const Type &type, Scope *scope);
     const Type *findTypeInNested(const Token *tok, const Scope *startScope) const;
     const Scope *findNamespace(const Token * tok, const Scope * scope) const;
     Function *findFunctionInScope(const Token *func, const Scope *ns);
@@ -904,7 +924,14 @@ private:
     std::vector<const Variable *> _variableList;
 
     /** list for missing types */
-    std::list<Type> _blankTypes;
+    std::deque<Type> _blankTypes;
+
+    /** type name => types in typeList with that name */
+    std::unordered_map<std::string, std::vector<const Type *> > _typesByName;
+
+    /** function call tokens, see functionCallTokens() */
+    mutable std::vector<const Token *> _functionCallTokens;
+    mutable bool _functionCallTokensCreated;
 };
 //---------------------------------------------------------------------------
 #endif // symboldatabaseH
@@ -22,6 +22,7 @@
 #include "tokenize.h"
 #include "errorlogger.h"
 #include "settings.h"
+#include "timer.h"
 #include <algorithm>
 #include <sstream>
 #include <list>
@@ -1175,13 +1176,30 @@ const Token * TemplateSimplifier::TemplateParametersInDeclaration(
     return tok;
 }
 
+std::string TemplateSimplifier::getTemplateName(const Token *tok)
+{
+    std::vector<const Token *> typeParametersInDeclaration;
+    tok = TemplateParametersInDeclaration(tok->tokAt(2), typeParametersInDeclaration);
+    if (!tok)
+        return "";
+
+    const int namepos = TemplateSimplifier::getTemplateNamePosition(tok);
+    if (namepos == -1)
+        return "";
+
+    return tok->strAt(namepos);
+}
+
 bool TemplateSimplifier::simplifyTemplateInstantiations(
     TokenList& tokenlist,
     ErrorLogger* errorlogger,
     const Settings *_settings,
     const Token *tok,
     std::list<Token *> &templateInstantiations,
-    std::set<std::string> &expandedtemplates)
+    std::set<std::string> &expandedtemplates,
+    std::size_t &instantiationCount,
+    std::set<std::string> &instantiatedNames,
+    TimerResults *timerResults)
 {
     // this variable is not used at the moment. The intention was to
     // allow continuous instantiations until all templates has been expanded
@@ -1297,8 +1315,21 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
         const std::string newName(name + "<" + typeForNewName + ">");
 
         if (expandedtemplates.find(newName) == expandedtemplates.end()) {
+            // instantiation budget exhausted => bail out
+            if (_settings->maxTemplateInstantiations > 0 && instantiationCount >= _settings->maxTemplateInstantiations)
+                break;
+
             expandedtemplates.insert(newName);
-            TemplateSimplifier::expandTemplate(tokenlist, tok,name,typeParametersInDeclaration,newName,typesUsedInTemplateInstantiation,templateInstantiations);
+            ++instantiationCount;
+            const std::size_t oldSize = templateInstantiations.size();
+            {
+                Timer t("TemplateSimplifier::expandTemplate", _settings->_showtime, timerResults);
+                TemplateSimplifier::expandTemplate(tokenlist, tok,name,typeParametersInDeclaration,newName,typesUsedInTemplateInstantiation,templateInstantiations);
+            }
+            // expandTemplate appends the instantiations found in the expanded code
+            auto added = templateInstantiations.rbegin();
+            for (std::size_t i = oldSize; i < templateInstantiations.size(); ++i, ++added)
+                instantiatedNames.insert((*added)->str());
             instantiated = true;
         }
 
@@ -1366,7 +1397,8 @@ void TemplateSimplifier::simplifyTemplates(
     TokenList& tokenlist,
     ErrorLogger* errorlogger,
     const Settings *_settings,
-    bool &_codeWithTemplates
+    bool &_codeWithTemplates,
+    TimerResults *timerResults
 )
 {
 
@@ -1406,16 +1438,41 @@ void TemplateSimplifier::simplifyTemplates(
     //while (!done)
     {
         //done = true;
+        // Names of all instantiated templates. Declarations that are never
+        // instantiated are skipped without walking the instantiation list.
+        // New instantiations are only added when a template is expanded,
+        // simplifyTemplateInstantiations() adds their names.
+        std::set<std::string> instantiatedNames;
+        for (auto it = templateInstantiations.begin(); it != templateInstantiations.end(); ++it)
+            instantiatedNames.insert((*it)->str());
+
+        std::size_t instantiationCount = 0;
         std::list<Token *> templates2;
         for (auto iter1 = templates.rbegin(); iter1 != templates.rend(); ++iter1) {
+            const std::string name(getTemplateName(*iter1));
+            if (!name.empty() && instantiatedNames.find(name) == instantiatedNames.end())
+                continue;
+
             bool instantiated = TemplateSimplifier::simplifyTemplateInstantiations(tokenlist,
                                 errorlogger,
                                 _settings,
                                 *iter1,
                                 templateInstantiations,
-                                expandedtemplates);
+                                expandedtemplates,
+                                instantiationCount,
+                                instantiatedNames,
+                                timerResults);
             if (instantiated)
                 templates2.push_back(*iter1);
+
+            if (_settings->maxTemplateInstantiations > 0 && instantiationCount >= _settings->maxTemplateInstantiations) {
+                if (_settings->debugwarnings && errorlogger) {
+                    std::list<const Token *> callstack(1, *iter1);
+                    errorlogger->reportErr(ErrorLogger::ErrorMessage(callstack, &tokenlist, Severity::debug, "debug",
+                                           "simplifyTemplates: bailing out, maximum number of template instantiations reached", false));
+                }
+                break;
+            }
         }
 
         for (auto it = templates2.begin(); it != templates2.end(); ++it) {
@@ -32,6 +32,7 @@ class Token;
 class TokenList;
 class ErrorLogger;
 class Settings;
+class TimerResults;
 
 
 /// @addtogroup Core
@@ -130,6 +131,13 @@ public:
         const Token * tok,
         std::vector<const Token *> & typeParametersInDeclaration);
 
+    /**
+     * Get the name of a template declaration
+     * @param tok token where the template declaration begins
+     * @return name of template class/function. Empty if it can't be determined.
+     */
+    static std::string getTemplateName(const Token *tok);
+
     /**
      * Simplify templates : expand all instantiations for a template
      * @todo It seems that inner templates should be instantiated recursively
@@ -139,6 +147,9 @@ public:
      * @param tok token where the template declaration begins
      * @param templateInstantiations a list of template usages (not necessarily just for this template)
      * @param expandedtemplates all templates that has been expanded so far. The full names are stored.
+     * @param instantiationCount number of instantiations done so far, checked against Settings::maxTemplateInstantiations
+     * @param instantiatedNames names of the template instantiations, the instantiations added by expanding this template are inserted
+     * @param timerResults timer results for --showtime, or 0
      * @return true if the template was instantiated
      */
     static bool simplifyTemplateInstantiations(
@@ -147,7 +158,10 @@ public:
         const Settings *_settings,
         const Token *tok,
         std::list<Token *> &templateInstantiations,
-        std::set<std::string> &expandedtemplates);
+        std::set<std::string> &expandedtemplates,
+        std::size_t &instantiationCount,
+        std::set<std::string> &instantiatedNames,
+        TimerResults *timerResults = 0);
 
     /**
      * Simplify templates
@@ -155,12 +169,14 @@ public:
      * @param errorlogger error logger
      * @param _settings settings
      * @param _codeWithTemplates output parameter that is set if code contains templates
+     * @param timerResults timer results for --showtime, or 0
      */
     static void simplifyTemplates(
         TokenList& tokenlist,
         ErrorLogger* errorlogger,
         const Settings *_settings,
-        bool &_codeWithTemplates);
+        bool &_codeWithTemplates,
+        TimerResults *timerResults = 0);
 
     /**
      * Simplify constant calculations such as "1+2" => "3"
@@ -32,6 +32,7 @@
 #include <cassert>
 #include <cctype>
 #include <stack>
+#include <unordered_map>
 #include <iostream>
 
 //---------------------------------------------------------------------------
@@ -43,7 +44,8 @@ list(0),
     _symbolDatabase(0),
     _varId(0),
     _codeWithTemplates(false), //is there any templates?
-    m_timerResults(nullptr)
+    m_timerResults(nullptr),
+    m_valueFlowCosts(nullptr)
 #ifdef MAXTIME
     ,maxtime(std::time(0) + MAXTIME)
 #endif
@@ -57,7 +59,8 @@ list(settings),
     _symbolDatabase(0),
     _varId(0),
     _codeWithTemplates(false), //is there any templates?
-    m_timerResults(nullptr)
+    m_timerResults(nullptr),
+    m_valueFlowCosts(nullptr)
 #ifdef MAXTIME
     ,maxtime(std::time(0) + MAXTIME)
 #endif
@@ -1637,7 +1640,12 @@ bool Tokenizer::tokenize(std::istream &code,
             }
 
             list.createAst();
-            ValueFlow::setValues(&list, _errorLogger, _settings);
+            if (m_timerResults) {
+                Timer t("Tokenizer::tokenize::ValueFlow", _settings->_showtime, m_timerResults);
+                ValueFlow::setValues(&list, _errorLogger, _settings, m_valueFlowCosts);
+            } else {
+                ValueFlow::setValues(&list, _errorLogger, _settings, m_valueFlowCosts);
+            }
         }
 
         return true;
@@ -2289,12 +2297,68 @@ void Tokenizer::simplifyTemplates()
         list,
         _errorLogger,
         _settings,
-        _codeWithTemplates);
+        _codeWithTemplates,
+        m_timerResults);
 }
 //---------------------------------------------------------------------------
 
 
-static bool setVarIdParseDeclaration(const Token **tok, const std::map<std::string,unsigned int> &variableId, bool executableScope, bool cpp, bool c)
+namespace {
+    /** name => variable id */
+    typedef std::unordered_map<std::string, unsigned int> VariableIdMap;
+
+    /**
+     * Variable ids for the names that are visible in the current scope.
+     * Entering a scope does not copy the visible names, instead each
+     * change is recorded so it can be undone when the scope is left.
+     */
+    class VariableIdScopes {
+    public:
+        const VariableIdMap &map() const {
+            return _variableId;
+        }
+
+        void set(const std::string &name, unsigned int varid) {
+            unsigned int &id = _variableId[name];
+            _changes.push_back(std::make_pair(name, id));
+            id = varid;
+        }
+
+        void enterScope() {
+            _scopeStart.push_back(_changes.size());
+        }
+
+        /** Restore the names that were visible when the scope was entered */
+        void leaveScope() {
+            if (_scopeStart.empty()) {
+                _variableId.clear();
+                _changes.clear();
+                return;
+            }
+            const std::size_t start = _scopeStart.back();
+            _scopeStart.pop_back();
+            while (_changes.size() > start) {
+                const std::pair<std::string, unsigned int> &change = _changes.back();
+                if (change.second == 0)
+                    _variableId.erase(change.first);
+                else
+                    _variableId[change.first] = change.second;
+                _changes.pop_back();
+            }
+        }
+
+    private:
+        VariableIdMap _variableId;
+
+        /** changed name and its previous variable id (0 => not visible before) */
+        std::vector<std::pair<std::string, unsigned int> > _changes;
+
+        /** size of _changes when each scope was entered */
+        std::vector<std::size_t> _scopeStart;
+    };
+}
+
+static bool setVarIdParseDeclaration(const Token **tok, const VariableIdMap &variableId, bool executableScope, bool cpp, bool c)
 {
     const Token *tok2 = *tok;
 
@@ -2439,7 +2503,7 @@ static const Token * findInitListEndToken(const Token *tok)
 }
 
 static void setVarIdClassDeclaration(Token * const startToken,
-    const std::map<std::string, unsigned int> &variableId,
+    const VariableIdMap &variableId,
     const unsigned int scopeStartVarId,
     std::map<unsigned int, std::map<std::string,unsigned int> > *structMembers,
     unsigned int *_varId)
@@ -2469,7 +2533,7 @@ static void setVarIdClassDeclaration(Token * const startToken,
         } else if (tok->str() == "}")
             --indentlevel;
         else if (initListEndToken && indentlevel == 0 && Token::Match(tok->previous(), "[,:] %var% [({]")) {
-            const std::map<std::string, unsigned int>::const_iterator it = variableId.find(tok->str());
+            const VariableIdMap::const_iterator it = variableId.find(tok->str());
             if (it != variableId.end()) {
                 tok->varId(it->second);
             }
@@ -2484,7 +2548,7 @@ static void setVarIdClassDeclaration(Token * const startToken,
                         continue;
                 }
 
-                const std::map<std::string, unsigned int>::const_iterator it = variableId.find(tok->str());
+                const VariableIdMap::const_iterator it = variableId.find(tok->str());
                 if (it != variableId.end()) {
                     tok->varId(it->second);
                     setVarIdStructMembers(&tok, structMembers, _varId);
@@ -2502,7 +2566,7 @@ static void setVarIdClassDeclaration(Token * const startToken,
 static void setVarIdClassFunction(const std::string &classname,
     Token * const startToken,
     const Token * const endToken,
-    const std::map<std::string, unsigned int> &varlist,
+    const VariableIdMap &varlist,
     std::map<unsigned int, std::map<std::string, unsigned int> > *structMembers,
     unsigned int *_varId)
 {
@@ -2516,7 +2580,7 @@ static void setVarIdClassFunction(const std::string &classname,
         if (Token::Match(tok2->tokAt(-2), "!!this ."))
             continue;
 
-        const std::map<std::string,unsigned int>::const_iterator it = varlist.find(tok2->str());
+        const VariableIdMap::const_iterator it = varlist.find(tok2->str());
         if (it != varlist.end()) {
             tok2->varId(it->second);
             setVarIdStructMembers(&tok2, structMembers, _varId);
@@ -2548,9 +2612,9 @@ void Tokenizer::setVarId()
 
     // variable id
     _varId = 0;
-    std::map<std::string, unsigned int> variableId;
+    VariableIdScopes scopeInfo;
+    const VariableIdMap &variableId = scopeInfo.map();
     std::map<unsigned int, std::map<std::string, unsigned int> > structMembers;
-    std::stack< std::map<std::string, unsigned int> > scopeInfo;
     std::stack<bool> executableScope;
     executableScope.push(false);
     std::stack<unsigned int> scopestartvarid;  // varid when scope starts
@@ -2570,14 +2634,13 @@ void Tokenizer::setVarId()
             }
         }
         if (newScope) {
-            scopeInfo.push(variableId);
+            scopeInfo.enterScope();
 
             // function declarations
         } else if (!executableScope.top() && tok->str() == "(" && Token::Match(tok->link(), ") const| ;")) {
-            scopeInfo.push(variableId);
+            scopeInfo.enterScope();
         } else if (!executableScope.top() && Token::Match(tok, ") const| ;")) {
-            variableId.swap(scopeInfo.top());
-            scopeInfo.pop();
+            scopeInfo.leaveScope();
 
         } else if (tok->str() == "{") {
             // parse anonymous unions as part of the current scope
@@ -2588,7 +2651,7 @@ void Tokenizer::setVarId()
                         executableScope.push(true);
                 } else {
                     executableScope.push(tok->strAt(-1) == "else");
-                    scopeInfo.push(variableId);
+                    scopeInfo.enterScope();
                 }
             }
             if (tok == initListEndToken)
@@ -2610,12 +2673,7 @@ void Tokenizer::setVarId()
                     scopestartvarid.push(0);
                 }
 
-                if (scopeInfo.empty()) {
-                    variableId.clear();
-                } else {
-                    variableId.swap(scopeInfo.top());
-                    scopeInfo.pop();
-                }
+                scopeInfo.leaveScope();
 
                 executableScope.pop();
                 if (executableScope.empty()) {   // should not possibly happen
@@ -2702,7 +2760,7 @@ void Tokenizer::setVarId()
                         decl = false;
 
                     if (decl) {
-                        variableId[prev2->str()] = ++_varId;
+                        scopeInfo.set(prev2->str(), ++_varId);
                         tok = tok2->previous();
                     }
                 }
@@ -2742,22 +2800,22 @@ void Tokenizer::setVarId()
     // are parsed. The old info is not bad, it is just redundant.
     structMembers.clear();
 
-    // Member functions and variables in this source
-    std::list<Token *> allMemberFunctions;
-    std::list<Token *> allMemberVars;
+    // Member functions and variables in this source, indexed by class name
+    std::unordered_map<std::string, std::list<Token *> > allMemberFunctions;
+    std::unordered_map<std::string, std::list<Token *> > allMemberVars;
     {
         for (Token *tok2 = list.front(); tok2; tok2 = tok2->next()) {
             if (Token::Match(tok2, "%var% :: %var%")) {
                 if (tok2->strAt(3) == "(")
-                    allMemberFunctions.push_back(tok2);
+                    allMemberFunctions[tok2->str()].push_back(tok2);
                 else if (tok2->strAt(3) != "::" && tok2->strAt(-1) != "::") // Support only one depth
-                    allMemberVars.push_back(tok2);
+                    allMemberVars[tok2->str()].push_back(tok2);
             }
         }
     }
 
     // class members..
-    std::map<std::string, std::map<std::string, unsigned int>> varlist;
+    std::unordered_map<std::string, VariableIdMap> varlist;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "namespace|class|struct %var% {|:")) {
             const std::string &classname(tok->next()->str());
@@ -2796,10 +2854,8 @@ void Tokenizer::setVarId()
                 continue;
 
             // Member variables
-            for (auto func = allMemberVars.begin(); func != allMemberVars.end(); ++func) {
-                if (!Token::simpleMatch(*func, classname.c_str()))
-                    continue;
-
+            const std::list<Token *> &memberVars = allMemberVars[classname];
+            for (auto func = memberVars.begin(); func != memberVars.end(); ++func) {
                 Token *tok2 = *func;
                 tok2 = tok2->tokAt(2);
                 tok2->varId(varlist[classname][tok2->str()]);
@@ -2809,35 +2865,32 @@ void Tokenizer::setVarId()
                 continue;
 
             // Set variable ids in member functions for this class..
-            const std::string funcpattern(classname + " :: %var% (");
-            for (auto func = allMemberFunctions.begin(); func != allMemberFunctions.end(); ++func) {
+            const std::list<Token *> &memberFunctions = allMemberFunctions[classname];
+            for (auto func = memberFunctions.begin(); func != memberFunctions.end(); ++func) {
                 Token *tok2 = *func;
 
-                // Found a class function..
-                if (Token::Match(tok2, funcpattern.c_str())) {
-                    // Goto the end parentheses..
-                    tok2 = tok2->linkAt(3);
-                    if (!tok2)
-                        break;
+                // Goto the end parentheses..
+                tok2 = tok2->linkAt(3);
+                if (!tok2)
+                    break;
 
-                    // If this is a function implementation.. add it to funclist
-                    Token * start = startOfFunction(tok2);
-                    if (start) {
-                        setVarIdClassFunction(classname, start, start->link(), varlist[classname], &structMembers, &_varId);
-                    }
+                // If this is a function implementation.. add it to funclist
+                Token * start = startOfFunction(tok2);
+                if (start) {
+                    setVarIdClassFunction(classname, start, start->link(), varlist[classname], &structMembers, &_varId);
+                }
 
-                    // constructor with initializer list
-                    if (Token::Match(tok2, ") : %var% (")) {
-                        Token *tok3 = tok2;
-                        while (Token::Match(tok3, ") [:,] %var% (")) {
-                            Token *vartok = tok3->tokAt(2);
-                            if (varlist[classname].find(vartok->str()) != varlist[classname].end())
-                                vartok->varId(varlist[classname][vartok->str()]);
-                            tok3 = tok3->linkAt(3);
-                        }
-                        if (Token::simpleMatch(tok3, ") {")) {
-                            setVarIdClassFunction(classname, tok2, tok3->next()->link(), varlist[classname], &structMembers, &_varId);
-                        }
+                // constructor with initializer list
+                if (Token::Match(tok2, ") : %var% (")) {
+                    Token *tok3 = tok2;
+                    while (Token::Match(tok3, ") [:,] %var% (")) {
+                        Token *vartok = tok3->tokAt(2);
+                        if (varlist[classname].find(vartok->str()) != varlist[classname].end())
+                            vartok->varId(varlist[classname][vartok->str()]);
+                        tok3 = tok3->linkAt(3);
+                    }
+                    if (Token::simpleMatch(tok3, ") {")) {
+                        setVarIdClassFunction(classname, tok2, tok3->next()->link(), varlist[classname], &structMembers, &_varId);
                     }
                 }
             }
@@ -3565,7 +3618,12 @@ bool Tokenizer::simplifyTokenList1(const char FileName[])
             ;
 
     // Handle templates..
-    simplifyTemplates();
+    if (m_timerResults) {
+        Timer t("Tokenizer::tokenize::simplifyTemplates", _settings->_showtime, m_timerResults);
+        simplifyTemplates();
+    } else {
+        simplifyTemplates();
+    }
 
     // The simplifyTemplates have inner loops
     if (_settings->terminated())
@@ -3853,7 +3911,12 @@ bool Tokenizer::simplifyTokenList2()
 
     list.createAst();
 
-    ValueFlow::setValues(&list, _errorLogger, _settings);
+    if (m_timerResults) {
+        Timer t("Tokenizer::simplifyTokenList2::ValueFlow", _settings->_showtime, m_timerResults);
+        ValueFlow::setValues(&list, _errorLogger, _settings, m_valueFlowCosts);
+    } else {
+        ValueFlow::setValues(&list, _errorLogger, _settings, m_valueFlowCosts);
+    }
 
     if (_settings->terminated())
         return false;
@@ -23,6 +23,7 @@
 
 #include "errorlogger.h"
 #include "tokenlist.h"
+#include "valueflow.h"
 #include "config.h"
 
 #include <string>
@@ -48,6 +49,11 @@ public:
         m_timerResults = tr;
     }
 
+    /** Collect the costs of the value flow analysis here */
+    void setValueFlowCosts(ValueFlow::Costs *costs) {
+        m_valueFlowCosts = costs;
+    }
+
     /** Is the code C. Used for bailouts */
     bool isC() const {
         return list.isC();
@@ -834,6 +840,11 @@ private:
      * TimerResults
      */
     TimerResults *m_timerResults;
+
+    /**
+     * Costs of the value flow analysis, or null
+     */
+    ValueFlow::Costs *m_valueFlowCosts;
 #ifdef MAXTIME
     /** Tokenizer maxtime */
     std::time_t maxtime;
@@ -23,21 +23,79 @@
 #include "symboldatabase.h"
 #include "token.h"
 #include "tokenlist.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
 #include <stack>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    /**
+     * Program memory: the known values of variables, sorted by varid.
+     * There are only a few variables in it so a flat vector is used, it
+     * is cheap to copy and to search.
+     */
+    class ProgramMemory {
+    public:
+        typedef std::pair<unsigned int, MathLib::bigint> value_type;
+        typedef std::vector<value_type>::iterator iterator;
+        typedef std::vector<value_type>::const_iterator const_iterator;
+
+        iterator begin() {
+            return _values.begin();
+        }
+        iterator end() {
+            return _values.end();
+        }
+        const_iterator begin() const {
+            return _values.begin();
+        }
+        const_iterator end() const {
+            return _values.end();
+        }
+
+        iterator find(unsigned int varid) {
+            const iterator it = std::lower_bound(_values.begin(), _values.end(), varid, lessVarId);
+            return (it != _values.end() && it->first == varid) ? it : _values.end();
+        }
+        const_iterator find(unsigned int varid) const {
+            const const_iterator it = std::lower_bound(_values.begin(), _values.end(), varid, lessVarId);
+            return (it != _values.end() && it->first == varid) ? it : _values.end();
+        }
+
+        MathLib::bigint &operator[](unsigned int varid) {
+            iterator it = std::lower_bound(_values.begin(), _values.end(), varid, lessVarId);
+            if (it == _values.end() || it->first != varid)
+                it = _values.insert(it, value_type(varid, 0));
+            return it->second;
+        }
+
+        bool empty() const {
+            return _values.empty();
+        }
+        void clear() {
+            _values.clear();
+        }
+        void swap(ProgramMemory &other) {
+            _values.swap(other._values);
+        }
+
+    private:
+        static bool lessVarId(const value_type &value, unsigned int varid) {
+            return value.first < varid;
+        }
+
+        std::vector<value_type> _values;
+    };
+}
 
 static void execute(const Token *expr,
-                    std::map<unsigned int, MathLib::bigint> * const programMemory,
+                    ProgramMemory * const programMemory,
                     MathLib::bigint *result,
                     bool *error);
 
-static void bailout(TokenList *tokenlist, ErrorLogger *errorLogger, const Token *tok, const std::string &what)
-{
-    std::list<ErrorLogger::ErrorMessage::FileLocation> callstack;
-    callstack.push_back(ErrorLogger::ErrorMessage::FileLocation(tok,tokenlist));
-    ErrorLogger::ErrorMessage errmsg(callstack, Severity::debug, "ValueFlow bailout: " + what, "valueFlowBailout", false);
-    errorLogger->reportErr(errmsg);
-}
-
 static bool bailoutFunctionPar(const Token *tok, const ValueFlow::Value &value, const Settings *settings, bool *inconclusive)
 {
     if (!tok)
@@ -98,7 +156,7 @@ static bool bailoutFunctionPar(const Token *tok, const ValueFlow::Value &value,
  * \param condition   top ast token in condition
  * \param programMemory   program memory
  */
-static bool conditionIsFalse(const Token *condition, const std::map<unsigned int, MathLib::bigint> &programMemory)
+static bool conditionIsFalse(const Token *condition, const ProgramMemory &programMemory)
 {
     if (!condition)
         return false;
@@ -107,7 +165,7 @@ static bool conditionIsFalse(const Token *condition, const std::map<unsigned int
         const bool result2 = result1 ? true : conditionIsFalse(condition->astOperand2(), programMemory);
         return result2;
     }
-    std::map<unsigned int, MathLib::bigint> progmem(programMemory);
+    ProgramMemory progmem(programMemory);
     MathLib::bigint result = 0;
     bool error = false;
     execute(condition, &progmem, &result, &error);
@@ -119,7 +177,7 @@ static bool conditionIsFalse(const Token *condition, const std::map<unsigned int
  * \param condition   top ast token in condition
  * \param programMemory   program memory
  */
-static bool conditionIsTrue(const Token *condition, const std::map<unsigned int, MathLib::bigint> &programMemory)
+static bool conditionIsTrue(const Token *condition, const ProgramMemory &programMemory)
 {
     if (!condition)
         return false;
@@ -128,7 +186,7 @@ static bool conditionIsTrue(const Token *condition, const std::map<unsigned int,
         const bool result2 = result1 ? true : conditionIsTrue(condition->astOperand2(), programMemory);
         return result2;
     }
-    std::map<unsigned int, MathLib::bigint> progmem(programMemory);
+    ProgramMemory progmem(programMemory);
     bool error = false;
     MathLib::bigint result = 0;
     execute(condition, &progmem, &result, &error);
@@ -138,11 +196,11 @@ static bool conditionIsTrue(const Token *condition, const std::map<unsigned int,
 /**
  * Get program memory by looking backwards from given token.
  */
-static std::map<unsigned int, MathLib::bigint> getProgramMemory(const Token *tok, unsigned int varid, const ValueFlow::Value &value)
+static ProgramMemory getProgramMemory(const Token *tok, unsigned int varid, const ValueFlow::Value &value)
 {
-    std::map<unsigned int, MathLib::bigint> programMemory;
+    ProgramMemory programMemory;
     programMemory[varid] = value.intvalue;
-    const std::map<unsigned int, MathLib::bigint> programMemory1(programMemory);
+    const ProgramMemory programMemory1(programMemory);
     int indentlevel = 0;
     for (const Token *tok2 = tok; tok2; tok2 = tok2->previous()) {
         if (Token::Match(tok2, "[;{}] %var% = %num% ;")) {
@@ -269,8 +327,170 @@ static bool isVariableChanged(const Token *start, const Token *end, const unsign
     return false;
 }
 
+namespace {
+    /**
+     * Def-use information for the variables in the token list. It is built
+     * once by ValueFlow::setValues(), the token list is not changed while
+     * the values are set. The ranges used in the queries are given the
+     * same way as for isVariableChanged(): [start,end), and if end is not
+     * found after start the range ends at the end of the token list.
+     */
+    class VariableUses {
+    public:
+        explicit VariableUses(const TokenList *tokenlist) {
+            std::size_t pos = 0;
+            for (const Token *tok = tokenlist->front(); tok; tok = tok->next(), ++pos) {
+                _positions[tok] = pos;
+                if (tok->varId() == 0U)
+                    continue;
+                _uses[tok->varId()].push_back(pos);
+                if (isVariableChanged(tok, tok->next(), tok->varId()))
+                    _changes[tok->varId()].push_back(pos);
+            }
+        }
+
+        /** is variable changed in the range? */
+        bool isChanged(const Token *start, const Token *end, unsigned int varid) const {
+            if (varid == 0U)
+                return isVariableChanged(start, end, varid);
+            return inRange(_changes, start, end, varid);
+        }
+
+        /** is variable used in the range? */
+        bool isUsed(const Token *start, const Token *end, unsigned int varid) const {
+            return inRange(_uses, start, end, varid);
+        }
+
+        /** position of the token in the token list */
+        std::size_t position(const Token *tok) const {
+            return _positions.find(tok)->second;
+        }
+
+    private:
+        typedef std::unordered_map<unsigned int, std::vector<std::size_t> > PositionsMap;
+
+        bool inRange(const PositionsMap &positionsMap, const Token *start, const Token *end, unsigned int varid) const {
+            if (!start || start == end)
+                return false;
+            const PositionsMap::const_iterator positions = positionsMap.find(varid);
+            if (positions == positionsMap.end())
+                return false;
+            const std::size_t first = position(start);
+            std::size_t last = end ? position(end) : std::string::npos;
+            if (last < first)
+                last = std::string::npos;
+            const auto it = std::lower_bound(positions->second.begin(), positions->second.end(), first);
+            return it != positions->second.end() && *it < last;
+        }
+
+        std::unordered_map<const Token *, std::size_t> _positions;
+        PositionsMap _uses;
+        PositionsMap _changes;
+    };
+}
+
+namespace {
+    /**
+     * Budgets of the value flow analysis (--valueflow-max-values and
+     * --valueflow-max-steps) and accounting of the costs per function.
+     * The costs are collected when --showtime is used.
+     */
+    class ValueFlowBudget {
+    public:
+        ValueFlowBudget(const Settings *settings, bool collectCosts)
+            : _maxValues(settings->valueFlowMaxValues),
+              _maxSteps(settings->valueFlowMaxSteps),
+              _debugwarnings(settings->debugwarnings),
+              _collectCosts(collectCosts),
+              _scope(nullptr),
+              _cost(nullptr) {
+        }
+
+        /** Can a new value be added to the token? */
+        bool addValue(const Token *tok) {
+            if (_maxValues && tok->values.size() >= _maxValues) {
+                cost(tok).bailouts.insert("max values");
+                return false;
+            }
+            if (_collectCosts)
+                ++cost(tok).values;
+            return true;
+        }
+
+        /** Can the value flow analysis take another step at the token? */
+        bool step(const Token *tok) {
+            if (!_maxSteps && !_collectCosts)
+                return true;
+            ValueFlow::Cost &c = cost(tok);
+            if (_maxSteps && c.steps >= _maxSteps) {
+                c.bailouts.insert("max steps");
+                return false;
+            }
+            ++c.steps;
+            return true;
+        }
+
+        /** Are bailouts reported (--debug-warnings) or collected (--showtime)? */
+        bool bailouts() const {
+            return _debugwarnings || _collectCosts;
+        }
+
+        /** Report a bailout of the analysis at the token and add it to the cost of the function */
+        void bailout(TokenList *tokenlist, ErrorLogger *errorLogger, const Token *tok, const std::string &what) {
+            if (_collectCosts)
+                cost(tok).reasons.insert(what);
+            if (_debugwarnings) {
+                std::list<ErrorLogger::ErrorMessage::FileLocation> callstack;
+                callstack.push_back(ErrorLogger::ErrorMessage::FileLocation(tok,tokenlist));
+                ErrorLogger::ErrorMessage errmsg(callstack, Severity::debug, "ValueFlow bailout: " + what, "valueFlowBailout", false);
+                errorLogger->reportErr(errmsg);
+            }
+        }
+
+        /** Add the costs of the functions to costs */
+        void addCosts(const TokenList *tokenlist, ValueFlow::Costs &costs) const {
+            for (auto it = _costs.begin(); it != _costs.end(); ++it) {
+                if (!it->first)
+                    continue;
+                const ErrorLogger::ErrorMessage::FileLocation loc(it->first->classDef, tokenlist);
+                std::ostringstream name;
+                name << it->first->className << " [" << loc.getfile(false) << ':' << loc.line << ']';
+                ValueFlow::Cost &c = costs[name.str()];
+                c.steps += it->second.steps;
+                c.values += it->second.values;
+                c.bailouts.insert(it->second.bailouts.begin(), it->second.bailouts.end());
+                c.reasons.insert(it->second.reasons.begin(), it->second.reasons.end());
+            }
+        }
+
+    private:
+        /** Cost of the function that the token belongs to */
+        ValueFlow::Cost &cost(const Token *tok) {
+            if (!_cost || tok->scope() != _scope) {
+                _scope = tok->scope();
+                const Scope *function = _scope;
+                while (function && function->type != Scope::eFunction)
+                    function = function->nestedIn;
+                _cost = &_costs[function];
+            }
+            return *_cost;
+        }
+
+        const unsigned int _maxValues;
+        const unsigned int _maxSteps;
+        const bool _debugwarnings;
+        const bool _collectCosts;
+
+        std::map<const Scope *, ValueFlow::Cost> _costs;
+
+        /** cached cost lookup */
+        const Scope *_scope;
+        ValueFlow::Cost *_cost;
+    };
+}
+
 /** set ValueFlow value and perform calculations if possible */
-static void setTokenValue(Token* tok, const ValueFlow::Value &value)
+static void setTokenValue(Token* tok, const ValueFlow::Value &value, ValueFlowBudget &budget)
 {
     // if value already exists, don't add it again
 	auto it = tok->values.begin();
@@ -296,6 +516,8 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value)
     }
 
     if (it == tok->values.end()) {
+        if (!budget.addValue(tok))
+            return;
         tok->values.push_back(value);
         it = tok->values.end();
         --it;
@@ -307,7 +529,7 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value)
 
     // Cast..
     if (parent && parent->str() == "(" && tok == parent->link()->next()) {
-        setTokenValue(parent,value);
+        setTokenValue(parent, value, budget);
     }
 
     // Calculations..
@@ -324,27 +546,27 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value)
                     switch (parent->str()[0]) {
                     case '+':
                         result.intvalue = value1->intvalue + value2->intvalue;
-                        setTokenValue(parent, result);
+                        setTokenValue(parent, result, budget);
                         break;
                     case '-':
                         result.intvalue = value1->intvalue - value2->intvalue;
-                        setTokenValue(parent, result);
+                        setTokenValue(parent, result, budget);
                         break;
                     case '*':
                         result.intvalue = value1->intvalue * value2->intvalue;
-                        setTokenValue(parent, result);
+                        setTokenValue(parent, result, budget);
                         break;
                     case '/':
                         if (value2->intvalue == 0)
                             break;
                         result.intvalue = value1->intvalue / value2->intvalue;
-                        setTokenValue(parent, result);
+                        setTokenValue(parent, result, budget);
                         break;
                     case '%':
                         if (value2->intvalue == 0)
                             break;
                         result.intvalue = value1->intvalue % value2->intvalue;
-                        setTokenValue(parent, result);
+                        setTokenValue(parent, result, budget);
                         break;
                     }
                 }
@@ -353,26 +575,26 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value)
     }
 }
 
-static void valueFlowNumber(TokenList *tokenlist)
+static void valueFlowNumber(TokenList *tokenlist, ValueFlowBudget &budget)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         if (tok->isNumber() && MathLib::isInt(tok->str()))
-            setTokenValue(tok, ValueFlow::Value(MathLib::toLongNumber(tok->str())));
+            setTokenValue(tok, ValueFlow::Value(MathLib::toLongNumber(tok->str())), budget);
     }
 }
 
-static void valueFlowString(TokenList *tokenlist)
+static void valueFlowString(TokenList *tokenlist, ValueFlowBudget &budget)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         if (tok->type() == Token::eString) {
             ValueFlow::Value strvalue;
             strvalue.tokvalue = tok;
-            setTokenValue(tok, strvalue);
+            setTokenValue(tok, strvalue, budget);
         }
     }
 }
 
-static void valueFlowPointerAlias(TokenList *tokenlist)
+static void valueFlowPointerAlias(TokenList *tokenlist, ValueFlowBudget &budget)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         // not address of
@@ -389,11 +611,11 @@ static void valueFlowPointerAlias(TokenList *tokenlist)
 
         ValueFlow::Value value;
         value.tokvalue = tok;
-        setTokenValue(tok, value);
+        setTokenValue(tok, value, budget);
     }
 }
 
-static void valueFlowBitAnd(TokenList *tokenlist)
+static void valueFlowBitAnd(TokenList *tokenlist, ValueFlowBudget &budget)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         if (tok->str() != "&")
@@ -415,13 +637,13 @@ static void valueFlowBitAnd(TokenList *tokenlist)
             ++bit;
 
         if ((1LL<<bit) == number) {
-            setTokenValue(tok, ValueFlow::Value(0));
-            setTokenValue(tok, ValueFlow::Value(number));
+            setTokenValue(tok, ValueFlow::Value(0), budget);
+            setTokenValue(tok, ValueFlow::Value(number), budget);
         }
     }
 }
 
-static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, const VariableUses &uses, ValueFlowBudget &budget)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         unsigned int varid=0;
@@ -457,8 +679,8 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
 
         // bailout: global non-const variables
         if (!(var->isLocal() || var->isArgument()) && !var->isConst()) {
-            if (settings->debugwarnings)
-                bailout(tokenlist, errorLogger, tok, "global variable " + var->name());
+            if (budget.bailouts())
+                budget.bailout(tokenlist, errorLogger, tok, "global variable " + var->name());
             continue;
         }
 
@@ -469,10 +691,10 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
 
             // Variable changed in 3rd for-expression
             if (Token::simpleMatch(tok2->previous(), "for (")) {
-                if (isVariableChanged(tok2->astOperand2()->astOperand2(), tok2->link(), varid)) {
+                if (uses.isChanged(tok2->astOperand2()->astOperand2(), tok2->link(), varid)) {
                     varid = 0U;
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok, "variable " + var->name() + " used in loop");
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok, "variable " + var->name() + " used in loop");
                 }
             }
 
@@ -481,18 +703,18 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
                 const Token * const start = tok2->link()->next();
                 const Token * const end   = start->link();
 
-                if (isVariableChanged(start,end,varid)) {
+                if (uses.isChanged(start,end,varid)) {
                     varid = 0U;
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok, "variable " + var->name() + " used in loop");
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok, "variable " + var->name() + " used in loop");
                 }
             }
 
             // if,macro => bailout
             else if (Token::simpleMatch(tok2->previous(), "if (") && tok2->previous()->isExpandedMacro()) {
                 varid = 0U;
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok, "variable " + var->name() + ", condition is defined in macro");
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok, "variable " + var->name() + ", condition is defined in macro");
             }
         }
         if (varid == 0U)
@@ -528,8 +750,8 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
             if (tok2->varId() == varid) {
                 // bailout: assignment
                 if (Token::Match(tok2->previous(), "!!* %var% =")) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "assignment of " + tok2->str());
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "assignment of " + tok2->str());
                     break;
                 }
 
@@ -539,15 +761,15 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
                 else if (Token::Match(tok2->tokAt(-2), "[;{}] ++|-- %var% ;"))
                     val.intvalue += (tok2->strAt(-1)=="++") ? -1 : 1;
                 else if (Token::Match(tok2->previous(), "++|-- %var%") || Token::Match(tok2, "%var% ++|--")) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "increment/decrement of " + tok2->str());
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "increment/decrement of " + tok2->str());
                     break;
                 }
 
                 // bailout: variable is used in rhs in assignment to itself
                 if (bailoutSelfAssignment(tok2)) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "variable " + tok2->str() + " is used in rhs in assignment to itself");
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "variable " + tok2->str() + " is used in rhs in assignment to itself");
                     break;
                 }
 
@@ -562,8 +784,8 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
                 // assigned by subfunction?
                 bool inconclusive = false;
                 if (bailoutFunctionPar(tok2,val2.condition ? val2 : val, settings, &inconclusive)) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "possible assignment of " + tok2->str() + " by subfunction");
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "possible assignment of " + tok2->str() + " by subfunction");
                     break;
                 }
                 val.inconclusive |= inconclusive;
@@ -571,17 +793,17 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
 
                 // skip if variable is conditionally used in ?: expression
                 if (const Token *parent = skipValueInConditionalExpression(tok2)) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist,
-                                errorLogger,
-                                tok2,
-                                "no simplification of " + tok2->str() + " within " + (Token::Match(parent,"[?:]") ? "?:" : parent->str()) + " expression");
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist,
+                                       errorLogger,
+                                       tok2,
+                                       "no simplification of " + tok2->str() + " within " + (Token::Match(parent,"[?:]") ? "?:" : parent->str()) + " expression");
                     continue;
                 }
 
-                setTokenValue(tok2, val);
+                setTokenValue(tok2, val, budget);
                 if (val2.condition)
-                    setTokenValue(tok2,val2);
+                    setTokenValue(tok2,val2, budget);
                 if (var && tok2 == var->nameToken())
                     break;
             }
@@ -592,8 +814,8 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
 
             // goto label
             if (Token::Match(tok2, "[;{}] %var% :")) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2->next(), "variable " + var->name() + " stopping on goto label");
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2->next(), "variable " + var->name() + " stopping on goto label");
                 break;
             }
 
@@ -602,12 +824,12 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
                 while (Token::Match(vartok, "%var% = %num% ;") && !vartok->tokAt(2)->getValue(num))
                     vartok = Token::findmatch(vartok->next(), "%varid%", tok2, varid);
                 if (vartok) {
-                    if (settings->debugwarnings) {
+                    if (budget.bailouts()) {
                         std::string errmsg = "variable ";
                         if (var)
                             errmsg += var->name() + " ";
                         errmsg += "stopping on }";
-                        bailout(tokenlist, errorLogger, tok2, errmsg);
+                        budget.bailout(tokenlist, errorLogger, tok2, errmsg);
                     }
                     break;
                 } else {
@@ -621,9 +843,9 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
 
                     const Token *start = tok2;
                     const Token *end   = start->link();
-                    if (isVariableChanged(start,end,varid)) {
-                        if (settings->debugwarnings)
-                            bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " is assigned in loop. so valueflow analysis bailout when start of loop is reached.");
+                    if (uses.isChanged(start,end,varid)) {
+                        if (budget.bailouts())
+                            budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " is assigned in loop. so valueflow analysis bailout when start of loop is reached.");
                         break;
                     }
                 }
@@ -642,8 +864,8 @@ static void valueFlowBeforeCondition(TokenList *tokenlist, ErrorLogger *errorLog
                     parent = parent->astParent();
                 // reaching a break/continue/return
                 if (parent) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " stopping on " + parent->str());
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " stopping on " + parent->str());
                     break;
                 }
             }
@@ -679,8 +901,14 @@ static bool valueFlowForward(Token * const               startToken,
                              const bool                  constValue,
                              TokenList * const           tokenlist,
                              ErrorLogger * const         errorLogger,
-                             const Settings * const      settings)
+                             const Settings * const      settings,
+                             const VariableUses &        uses,
+                             ValueFlowBudget &           budget)
 {
+    // Once the variable is not used anymore, the remaining code can only
+    // cause bailouts. Stop then unless the bailouts are reported.
+    const bool stopAfterLastUse = !settings->debugwarnings;
+
     int indentlevel = 0;
     unsigned int number_of_if = 0;
     int varusagelevel = -1;
@@ -689,6 +917,15 @@ static bool valueFlowForward(Token * const               startToken,
 
     for (Token *tok2 = startToken; tok2 && tok2 != endToken; tok2 = tok2->next()) 
     {
+        if (stopAfterLastUse && Token::Match(tok2, "[;}]") && !uses.isUsed(tok2, nullptr, varid))
+            return true;
+
+        if (!budget.step(tok2)) {
+            if (budget.bailouts())
+                budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " valueFlowForward, step budget exhausted");
+            return false;
+        }
+
         if (indentlevel >= 0 && tok2->str() == "{")
             ++indentlevel;
         else if (indentlevel >= 0 && tok2->str() == "}") 
@@ -699,8 +936,8 @@ static bool valueFlowForward(Token * const               startToken,
                 const Token *condition = tok2->link()->linkAt(-1)->astOperand2();
                 if (!condition) 
                 {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "variable " + var->name() 
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() 
                             + " valueFlowForward, bailing out since it's unknown if conditional return is executed");
                     return false;
                 }
@@ -716,8 +953,8 @@ static bool valueFlowForward(Token * const               startToken,
                 }
                 if (bailoutflag) 
                 {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "variable " 
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "variable " 
                             + var->name() + " valueFlowForward, conditional return is assumed to be executed");
                     return false;
                 }
@@ -750,9 +987,9 @@ static bool valueFlowForward(Token * const               startToken,
         else if (Token::Match(tok2, "%var% (") && Token::simpleMatch(tok2->linkAt(1), ") {")) 
         {
             // is variable changed in condition?
-            if (isVariableChanged(tok2->next(), tok2->next()->link(), varid)) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " valueFlowForward, assignment in condition");
+            if (uses.isChanged(tok2->next(), tok2->next()->link(), varid)) {
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " valueFlowForward, assignment in condition");
                 return false;
             }
 
@@ -775,9 +1012,11 @@ static bool valueFlowForward(Token * const               startToken,
                                  constValue,
                                  tokenlist,
                                  errorLogger,
-                                 settings);
+                                 settings,
+                                 uses,
+                                 budget);
 
-                if (isVariableChanged(startToken1, startToken1->link(), varid))
+                if (uses.isChanged(startToken1, startToken1->link(), varid))
                     removeValues(values, truevalues);
 
                 // goto '}'
@@ -788,7 +1027,7 @@ static bool valueFlowForward(Token * const               startToken,
             Token * const start = tok2->linkAt(1)->next();
             Token * const end   = start->link();
             bool varusage = (indentlevel >= 0 && constValue && number_of_if == 0U) ?
-                            isVariableChanged(start,end,varid) :
+                            uses.isChanged(start,end,varid) :
                             (nullptr != Token::findmatch(start, "%varid%", end, varid));
             if (!read) {
                 read = bool(nullptr != Token::findmatch(tok2, "%varid% !!=", end, varid));
@@ -810,19 +1049,19 @@ static bool valueFlowForward(Token * const               startToken,
                         if (condtok->varId() == varid) {
                             std::list<ValueFlow::Value>::const_iterator it;
                             for (it = values.begin(); it != values.end(); ++it)
-                                setTokenValue(condtok, *it);
+                                setTokenValue(condtok, *it, budget);
                         }
                         if (Token::Match(condtok, "%oror%|&&"))
                             break;
                     }
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " is assigned in conditional code");
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " is assigned in conditional code");
                     return false;
                 }
 
                 if (var->isStatic()) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " bailout when conditional code that contains var is seen");
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " bailout when conditional code that contains var is seen");
                     return false;
                 }
 
@@ -841,12 +1080,12 @@ static bool valueFlowForward(Token * const               startToken,
                 (Token::findmatch(start, "return|continue|break|throw", end) ||
                  (Token::simpleMatch(end,"} else {") && Token::findmatch(end, "return|continue|break|throw", end->linkAt(2))))) 
             {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + ". noreturn conditional scope.");
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + ". noreturn conditional scope.");
                 return false;
             }
 
-            if (isVariableChanged(start, end, varid)) 
+            if (uses.isChanged(start, end, varid)) 
             {
                 if ((!read || number_of_if == 0) &&
                     Token::simpleMatch(tok2, "if (") &&
@@ -884,8 +1123,8 @@ static bool valueFlowForward(Token * const               startToken,
                     }
 
                     if (bail) {
-                        if (settings->debugwarnings)
-                            bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " is assigned in conditional code");
+                        if (budget.bailouts())
+                            budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " is assigned in conditional code");
                         return false;
                     }
                 }
@@ -916,8 +1155,8 @@ static bool valueFlowForward(Token * const               startToken,
                     continue;
                 }
             }
-            if (settings->debugwarnings)
-                bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + ". noreturn conditional scope.");
+            if (budget.bailouts())
+                budget.bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + ". noreturn conditional scope.");
             return false;
         }
 
@@ -936,21 +1175,21 @@ static bool valueFlowForward(Token * const               startToken,
                 for (Token *tok3 = tok2->tokAt(2); tok3; tok3 = tok3->next()) {
                     if (tok3->varId() == varid) {
                         for (auto it = values.begin(); it != values.end(); ++it) {
-                            setTokenValue(tok3, *it);
+                            setTokenValue(tok3, *it, budget);
 						}
                     } else if (Token::Match(tok3, "++|--|?|:|;")) {
                         break;
 					}
                 }
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2, "assignment of " + tok2->str());
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2, "assignment of " + tok2->str());
                 return false;
             }
 
             // bailout increment/decrement for now..
             if (Token::Match(tok2->previous(), "++|-- %var%") || Token::Match(tok2, "%var% ++|--")) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2, "increment/decrement of " + tok2->str());
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2, "increment/decrement of " + tok2->str());
                 return false;
             }
 
@@ -961,8 +1200,8 @@ static bool valueFlowForward(Token * const               startToken,
                 while (Token::simpleMatch(parent,">>"))
                     parent = parent->astParent();
                 if (!parent) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "Possible assignment of " + tok2->str() + " using >>");
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "Possible assignment of " + tok2->str() + " using >>");
                     return false;
                 }
             }
@@ -970,11 +1209,11 @@ static bool valueFlowForward(Token * const               startToken,
             // skip if variable is conditionally used in ?: expression
             if (const Token *parent = skipValueInConditionalExpression(tok2)) 
             {
-                if (settings->debugwarnings)
-                    bailout(tokenlist,
-                            errorLogger,
-                            tok2,
-                            "no simplification of " + tok2->str() + " within " + (Token::Match(parent,"[?:]") ? "?:" : parent->str()) + " expression");
+                if (budget.bailouts())
+                    budget.bailout(tokenlist,
+                                   errorLogger,
+                                   tok2,
+                                   "no simplification of " + tok2->str() + " within " + (Token::Match(parent,"[?:]") ? "?:" : parent->str()) + " expression");
                 const Token *astTop = parent->astTop();
                 if (Token::simpleMatch(astTop->astOperand1(), "for ("))
                     tok2 = const_cast<Token*>(astTop->link());
@@ -983,29 +1222,29 @@ static bool valueFlowForward(Token * const               startToken,
 
             {
                 for (auto it = values.begin(); it != values.end(); ++it) {
-                    setTokenValue(tok2, *it);
+                    setTokenValue(tok2, *it, budget);
 				}
             }
 
             // bailout if address of var is taken..
             if (tok2->astParent() && tok2->astParent()->str() == "&" && !tok2->astParent()->astOperand2()) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2, "Taking address of " + tok2->str());
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2, "Taking address of " + tok2->str());
                 return false;
             }
 
             // bailout if reference is created..
             if (tok2->astParent() && Token::Match(tok2->astParent()->tokAt(-2), "& %var% =")) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2, "Reference of " + tok2->str());
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2, "Reference of " + tok2->str());
                 return false;
             }
 
             // assigned by subfunction?
             bool inconclusive = false;
             if (bailoutFunctionPar(tok2, ValueFlow::Value(), settings, &inconclusive)) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2, "possible assignment of " + tok2->str() + " by subfunction");
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2, "possible assignment of " + tok2->str() + " by subfunction");
                 return false;
             }
             if (inconclusive) {
@@ -1018,7 +1257,7 @@ static bool valueFlowForward(Token * const               startToken,
     return true;
 }
 
-static void valueFlowAfterAssign(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowAfterAssign(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, const VariableUses &uses, ValueFlowBudget &budget)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         // Assignment
@@ -1043,11 +1282,11 @@ static void valueFlowAfterAssign(TokenList *tokenlist, ErrorLogger *errorLogger,
 
         const std::list<ValueFlow::Value>& values = tok->astOperand2()->values;
         const bool constValue = tok->astOperand2()->isNumber();
-        valueFlowForward(tok, endOfVarScope, var, varid, values, constValue, tokenlist, errorLogger, settings);
+        valueFlowForward(tok, endOfVarScope, var, varid, values, constValue, tokenlist, errorLogger, settings, uses, budget);
     }
 }
 
-static void valueFlowAfterCondition(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowAfterCondition(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, const VariableUses &uses, ValueFlowBudget &budget)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         const Token *vartok, *numtok;
@@ -1111,7 +1350,7 @@ static void valueFlowAfterCondition(TokenList *tokenlist, ErrorLogger *errorLogg
                         tokens.push(const_cast<Token*>(rhstok->astOperand1()));
                         tokens.push(const_cast<Token*>(rhstok->astOperand2()));
                         if (rhstok->varId() == varid)
-                            setTokenValue(rhstok, values.front());
+                            setTokenValue(rhstok, values.front(), budget);
                         if (Token::Match(rhstok, "++|--|=") && Token::Match(rhstok->astOperand1(),"%varid%",varid)) {
                             assign = true;
                             break;
@@ -1128,9 +1367,9 @@ static void valueFlowAfterCondition(TokenList *tokenlist, ErrorLogger *errorLogg
             // does condition reassign variable?
             if (tok != top->astOperand2() &&
                 Token::Match(top->astOperand2(), "%oror%|&&") &&
-                isVariableChanged(top,top->link(),varid)) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok, "assignment in condition");
+                uses.isChanged(top,top->link(),varid)) {
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok, "assignment in condition");
                 continue;
             }
 
@@ -1162,15 +1401,15 @@ static void valueFlowAfterCondition(TokenList *tokenlist, ErrorLogger *errorLogg
 
             bool ok = true;
             if (startToken)
-                ok = valueFlowForward(startToken->next(), startToken->link(), var, varid, values, true, tokenlist, errorLogger, settings);
+                ok = valueFlowForward(startToken->next(), startToken->link(), var, varid, values, true, tokenlist, errorLogger, settings, uses, budget);
 
             // After conditional code..
             if (ok && Token::simpleMatch(top->link(), ") {")) {
                 Token *after = top->link()->linkAt(1);
                 std::string unknownFunction;
                 if (settings->library.isScopeNoReturn(after,&unknownFunction)) {
-                    if (settings->debugwarnings && !unknownFunction.empty())
-                        bailout(tokenlist, errorLogger, after, "possible noreturn scope");
+                    if (budget.bailouts() && !unknownFunction.empty())
+                        budget.bailout(tokenlist, errorLogger, after, "possible noreturn scope");
                     continue;
                 }
 
@@ -1179,8 +1418,8 @@ static void valueFlowAfterCondition(TokenList *tokenlist, ErrorLogger *errorLogg
                 if (Token::simpleMatch(after, "} else {")) {
                     after = after->linkAt(2);
                     if (Token::simpleMatch(after->tokAt(-2), ") ; }")) {
-                        if (settings->debugwarnings)
-                            bailout(tokenlist, errorLogger, after, "possible noreturn scope");
+                        if (budget.bailouts())
+                            budget.bailout(tokenlist, errorLogger, after, "possible noreturn scope");
                         continue;
                     }
                     isreturn |= (codeblock == 2 && isReturn(after));
@@ -1190,7 +1429,7 @@ static void valueFlowAfterCondition(TokenList *tokenlist, ErrorLogger *errorLogg
                     // TODO: constValue could be true if there are no assignments in the conditional blocks and
                     //       perhaps if there are no && and no || in the condition
                     bool constValue = false;
-                    valueFlowForward(after->next(), top->scope()->classEnd, var, varid, values, constValue, tokenlist, errorLogger, settings);
+                    valueFlowForward(after->next(), top->scope()->classEnd, var, varid, values, constValue, tokenlist, errorLogger, settings, uses, budget);
                 }
             }
         }
@@ -1198,7 +1437,7 @@ static void valueFlowAfterCondition(TokenList *tokenlist, ErrorLogger *errorLogg
 }
 
 static void execute(const Token *expr,
-                    std::map<unsigned int, MathLib::bigint> * const programMemory,
+                    ProgramMemory * const programMemory,
                     MathLib::bigint *result,
                     bool *error)
 {
@@ -1360,15 +1599,15 @@ static bool valueFlowForLoop1(const Token *tok, unsigned int * const varid, Math
 }
 
 static bool valueFlowForLoop2(const Token *tok,
-                              std::map<unsigned int, MathLib::bigint> *memory1,
-                              std::map<unsigned int, MathLib::bigint> *memory2,
-                              std::map<unsigned int, MathLib::bigint> *memoryAfter)
+                              ProgramMemory *memory1,
+                              ProgramMemory *memory2,
+                              ProgramMemory *memoryAfter)
 {
     const Token *firstExpression  = tok->next()->astOperand2()->astOperand1();
     const Token *secondExpression = tok->next()->astOperand2()->astOperand2()->astOperand1();
     const Token *thirdExpression = tok->next()->astOperand2()->astOperand2()->astOperand2();
 
-    std::map<unsigned int, MathLib::bigint> programMemory;
+    ProgramMemory programMemory;
     MathLib::bigint result(0);
     bool error = false;
     execute(firstExpression, &programMemory, &result, &error);
@@ -1392,8 +1631,8 @@ static bool valueFlowForLoop2(const Token *tok,
         }
     }
 
-    std::map<unsigned int, MathLib::bigint> startMemory(programMemory);
-    std::map<unsigned int, MathLib::bigint> endMemory;
+    ProgramMemory startMemory(programMemory);
+    ProgramMemory endMemory;
 
     unsigned int maxcount = 10000;
     while (result != 0 && !error && --maxcount) {
@@ -1412,15 +1651,21 @@ static bool valueFlowForLoop2(const Token *tok,
     return true;
 }
 
-static void valueFlowForLoopSimplify(Token * const bodyStart, const unsigned int varid, const MathLib::bigint value, TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowForLoopSimplify(Token * const bodyStart, const unsigned int varid, const MathLib::bigint value, TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, const VariableUses &uses, ValueFlowBudget &budget)
 {
     const Token * const bodyEnd = bodyStart->link();
 
     // Is variable modified inside for loop
-    if (isVariableChanged(bodyStart, bodyEnd, varid))
+    if (uses.isChanged(bodyStart, bodyEnd, varid))
         return;
 
     for (Token *tok2 = bodyStart->next(); tok2 != bodyEnd; tok2 = tok2->next()) {
+        if (!budget.step(tok2)) {
+            if (budget.bailouts())
+                budget.bailout(tokenlist, errorLogger, tok2, "For loop variable step budget exhausted");
+            break;
+        }
+
         if (tok2->varId() == varid) {
             const Token * parent = tok2->astParent();
             while (parent) {
@@ -1435,18 +1680,18 @@ static void valueFlowForLoopSimplify(Token * const bodyStart, const unsigned int
                 }
             }
             if (parent) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2, "For loop variable " + tok2->str() + " stopping on ?");
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2, "For loop variable " + tok2->str() + " stopping on ?");
                 continue;
             }
 
             ValueFlow::Value value1(value);
             value1.varId = tok2->varId();
-            setTokenValue(tok2, value1);
+            setTokenValue(tok2, value1, budget);
         }
 
         if (Token::Match(tok2, "%oror%|&&")) {
-            const std::map<unsigned int, MathLib::bigint> programMemory(getProgramMemory(tok2->astTop(), varid, value));
+            const ProgramMemory programMemory(getProgramMemory(tok2->astTop(), varid, value));
             if ((tok2->str() == "&&" && conditionIsFalse(tok2->astOperand1(), programMemory)) ||
                 (tok2->str() == "||" && conditionIsTrue(tok2->astOperand1(), programMemory))) {
                 // Skip second expression..
@@ -1469,17 +1714,17 @@ static void valueFlowForLoopSimplify(Token * const bodyStart, const unsigned int
 
         else if (Token::simpleMatch(tok2, ") {") && Token::findmatch(tok2->link(), "%varid%", tok2, varid)) {
             if (Token::findmatch(tok2, "continue|break|return", tok2->linkAt(1), varid)) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok2, "For loop variable bailout on conditional continue|break|return");
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok2, "For loop variable bailout on conditional continue|break|return");
                 break;
             }
-            if (settings->debugwarnings)
-                bailout(tokenlist, errorLogger, tok2, "For loop variable skipping conditional scope");
+            if (budget.bailouts())
+                budget.bailout(tokenlist, errorLogger, tok2, "For loop variable skipping conditional scope");
             tok2 = tok2->next()->link();
             if (Token::simpleMatch(tok2, "} else {")) {
                 if (Token::findmatch(tok2, "continue|break|return", tok2->linkAt(2), varid)) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "For loop variable bailout on conditional continue|break|return");
+                    if (budget.bailouts())
+                        budget.bailout(tokenlist, errorLogger, tok2, "For loop variable bailout on conditional continue|break|return");
                     break;
                 }
 
@@ -1489,7 +1734,7 @@ static void valueFlowForLoopSimplify(Token * const bodyStart, const unsigned int
     }
 }
 
-static void valueFlowForLoopSimplifyAfter(Token *fortok, unsigned int varid, const MathLib::bigint num, TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowForLoopSimplifyAfter(Token *fortok, unsigned int varid, const MathLib::bigint num, TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, const VariableUses &uses, ValueFlowBudget &budget)
 {
     const Token *vartok = nullptr;
     for (const Token *tok = fortok; tok; tok = tok->next()) {
@@ -1519,10 +1764,12 @@ static void valueFlowForLoopSimplifyAfter(Token *fortok, unsigned int varid, con
                      false,
                      tokenlist,
                      errorLogger,
-                     settings);
+                     settings,
+                     uses,
+                     budget);
 }
 
-static void valueFlowForLoop(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowForLoop(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, const VariableUses &uses, ValueFlowBudget &budget)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         if (!Token::simpleMatch(tok, "for (") ||
@@ -1539,27 +1786,45 @@ static void valueFlowForLoop(TokenList *tokenlist, ErrorLogger *errorLogger, con
 
         if (valueFlowForLoop1(tok, &varid, &num1, &num2, &numAfter)) {
             if (num1 <= num2) {
-                valueFlowForLoopSimplify(bodyStart, varid, num1, tokenlist, errorLogger, settings);
-                valueFlowForLoopSimplify(bodyStart, varid, num2, tokenlist, errorLogger, settings);
-                valueFlowForLoopSimplifyAfter(tok, varid, numAfter, tokenlist, errorLogger, settings);
+                valueFlowForLoopSimplify(bodyStart, varid, num1, tokenlist, errorLogger, settings, uses, budget);
+                valueFlowForLoopSimplify(bodyStart, varid, num2, tokenlist, errorLogger, settings, uses, budget);
+                valueFlowForLoopSimplifyAfter(tok, varid, numAfter, tokenlist, errorLogger, settings, uses, budget);
             } else
-                valueFlowForLoopSimplifyAfter(tok, varid, num1, tokenlist, errorLogger, settings);
+                valueFlowForLoopSimplifyAfter(tok, varid, num1, tokenlist, errorLogger, settings, uses, budget);
         } else {
-            std::map<unsigned int, MathLib::bigint> mem1, mem2, memAfter;
+            ProgramMemory mem1, mem2, memAfter;
             if (valueFlowForLoop2(tok, &mem1, &mem2, &memAfter)) {
                 for (auto it = mem1.begin(); it != mem1.end(); ++it)
-                    valueFlowForLoopSimplify(bodyStart, it->first, it->second, tokenlist, errorLogger, settings);
+                    valueFlowForLoopSimplify(bodyStart, it->first, it->second, tokenlist, errorLogger, settings, uses, budget);
                 for (auto it = mem2.begin(); it != mem2.end(); ++it)
-                    valueFlowForLoopSimplify(bodyStart, it->first, it->second, tokenlist, errorLogger, settings);
+                    valueFlowForLoopSimplify(bodyStart, it->first, it->second, tokenlist, errorLogger, settings, uses, budget);
                 for (auto it = memAfter.begin(); it != memAfter.end(); ++it)
-                    valueFlowForLoopSimplifyAfter(tok, it->first, it->second, tokenlist, errorLogger, settings);
+                    valueFlowForLoopSimplifyAfter(tok, it->first, it->second, tokenlist, errorLogger, settings, uses, budget);
             }
         }
     }
 }
 
-static void valueFlowSubFunction(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings)
+namespace {
+    /** Summary of how a parameter value is used in the function body */
+    struct ParameterSummary {
+        ParameterSummary() : stopToken(nullptr), budgetExhausted(false) {
+        }
+
+        /** the parameter tokens that get the passed values */
+        std::vector<Token *> tokens;
+
+        /** the token where the propagation of the values stops */
+        const Token *stopToken;
+        bool budgetExhausted;
+    };
+}
+
+static void valueFlowSubFunction(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, ValueFlowBudget &budget)
 {
+    // summaries of the parameters, computed once and used at all call sites
+    std::unordered_map<unsigned int, ParameterSummary> summaries;
+
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         if (!Token::Match(tok, "%var% ("))
             continue;
@@ -1607,17 +1872,40 @@ static void valueFlowSubFunction(TokenList *tokenlist, ErrorLogger *errorLogger,
                 !Token::Match(arg->typeStartToken(), "const| struct| %type% * %var% ,|)"))
                 continue;
 
-            // Set value in function scope..
+            // Summary of the parameter usage..
             const unsigned int varid2 = arg->declarationId();
-            for (const Token *tok2 = functionScope->classStart->next(); tok2 != functionScope->classEnd; tok2 = tok2->next()) {
-                if (Token::Match(tok2, "%varid% !!=", varid2)) {
-                    for (std::list<ValueFlow::Value>::const_iterator val = argvalues.begin(); val != argvalues.end(); ++val)
-                        setTokenValue(const_cast<Token*>(tok2), *val);
-                } else if (Token::Match(tok2, "%oror%|&&|{|?")) {
-                    if (settings->debugwarnings)
-                        bailout(tokenlist, errorLogger, tok2, "parameter " + arg->name() + ", at '" + tok2->str() + "'");
-                    break;
+            const auto cached = summaries.find(varid2);
+            const ParameterSummary *summary;
+            if (cached != summaries.end())
+                summary = &cached->second;
+            else {
+                ParameterSummary &newSummary = summaries[varid2];
+                for (Token *tok2 = functionScope->classStart->next(); tok2 != functionScope->classEnd; tok2 = tok2->next()) {
+                    if (!budget.step(tok2)) {
+                        newSummary.stopToken = tok2;
+                        newSummary.budgetExhausted = true;
+                        break;
+                    }
+                    if (Token::Match(tok2, "%varid% !!=", varid2))
+                        newSummary.tokens.push_back(tok2);
+                    else if (Token::Match(tok2, "%oror%|&&|{|?")) {
+                        newSummary.stopToken = tok2;
+                        break;
+                    }
                 }
+                summary = &newSummary;
+            }
+
+            // Set value in function scope..
+            for (auto tok2 = summary->tokens.begin(); tok2 != summary->tokens.end(); ++tok2) {
+                for (std::list<ValueFlow::Value>::const_iterator val = argvalues.begin(); val != argvalues.end(); ++val)
+                    setTokenValue(*tok2, *val, budget);
+            }
+            if (summary->stopToken && budget.bailouts()) {
+                if (summary->budgetExhausted)
+                    budget.bailout(tokenlist, errorLogger, summary->stopToken, "parameter " + arg->name() + ", step budget exhausted");
+                else
+                    budget.bailout(tokenlist, errorLogger, summary->stopToken, "parameter " + arg->name() + ", at '" + summary->stopToken->str() + "'");
             }
         }
     }
@@ -1628,8 +1916,11 @@ static bool constval(const Token * tok)
     return tok && tok->values.size() == 1U && tok->values.front().varId == 0U;
 }
 
-static void valueFlowFunctionReturn(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings)
+static void valueFlowFunctionReturn(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, ValueFlowBudget &budget)
 {
+    // return values of the functions for given constant arguments. error => no value
+    std::map<std::pair<const Function *, std::vector<MathLib::bigint> >, std::pair<bool, MathLib::bigint> > returnValues;
+
     for (Token *tok = tokenlist->front(); tok; tok = tok->next()) {
         if (tok->str() != "(" || !tok->astOperand1() || !tok->astOperand1()->function())
             continue;
@@ -1656,17 +1947,26 @@ static void valueFlowFunctionReturn(TokenList *tokenlist, ErrorLogger *errorLogg
         const Function * const function = tok->astOperand1()->function();
         const Scope * const functionScope = function ? function->functionScope : nullptr;
         if (!functionScope || !Token::simpleMatch(functionScope->classStart, "{ return")) {
-            if (functionScope && settings->debugwarnings)
-                bailout(tokenlist, errorLogger, tok, "function return; nontrivial function body");
+            if (functionScope && budget.bailouts())
+                budget.bailout(tokenlist, errorLogger, tok, "function return; nontrivial function body");
+            continue;
+        }
+
+        // Already evaluated with the same arguments?
+        const std::pair<const Function *, std::vector<MathLib::bigint> > key(function, parvalues);
+        const auto cached = returnValues.find(key);
+        if (cached != returnValues.end()) {
+            if (!cached->second.first)
+                setTokenValue(tok, ValueFlow::Value(cached->second.second), budget);
             continue;
         }
 
-        std::map<unsigned int, MathLib::bigint> programMemory;
+        ProgramMemory programMemory;
         for (std::size_t i = 0; i < parvalues.size(); ++i) {
             const Variable * const arg = function->getArgumentVar(i);
             if (!arg || !Token::Match(arg->typeStartToken(), "%type% %var% ,|)")) {
-                if (settings->debugwarnings)
-                    bailout(tokenlist, errorLogger, tok, "function return; unhandled argument type");
+                if (budget.bailouts())
+                    budget.bailout(tokenlist, errorLogger, tok, "function return; unhandled argument type");
                 programMemory.clear();
                 break;
             }
@@ -1682,24 +1982,53 @@ static void valueFlowFunctionReturn(TokenList *tokenlist, ErrorLogger *errorLogg
                 &programMemory,
                 &result,
                 &error);
+        returnValues[key] = std::make_pair(error, result);
         if (!error)
-            setTokenValue(tok, ValueFlow::Value(result));
+            setTokenValue(tok, ValueFlow::Value(result), budget);
     }
 }
 
-void ValueFlow::setValues(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings)
+void ValueFlow::setValues(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, Costs *costs)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next())
         tok->values.clear();
 
-    valueFlowNumber(tokenlist);
-    valueFlowString(tokenlist);
-    valueFlowPointerAlias(tokenlist);
-    valueFlowFunctionReturn(tokenlist, errorLogger, settings);
-    valueFlowBitAnd(tokenlist);
-    valueFlowForLoop(tokenlist, errorLogger, settings);
-    valueFlowBeforeCondition(tokenlist, errorLogger, settings);
-    valueFlowAfterAssign(tokenlist, errorLogger, settings);
-    valueFlowAfterCondition(tokenlist, errorLogger, settings);
-    valueFlowSubFunction(tokenlist, errorLogger, settings);
+    ValueFlowBudget budget(settings, costs != nullptr);
+    valueFlowNumber(tokenlist, budget);
+    valueFlowString(tokenlist, budget);
+    valueFlowPointerAlias(tokenlist, budget);
+    valueFlowFunctionReturn(tokenlist, errorLogger, settings, budget);
+    valueFlowBitAnd(tokenlist, budget);
+    const VariableUses uses(tokenlist);
+    valueFlowForLoop(tokenlist, errorLogger, settings, uses, budget);
+    valueFlowBeforeCondition(tokenlist, errorLogger, settings, uses, budget);
+    valueFlowAfterAssign(tokenlist, errorLogger, settings, uses, budget);
+    valueFlowAfterCondition(tokenlist, errorLogger, settings, uses, budget);
+    valueFlowSubFunction(tokenlist, errorLogger, settings, budget);
+
+    if (costs)
+        budget.addCosts(tokenlist, *costs);
+}
+
+std::list<std::string> ValueFlow::costReport(const Costs &costs)
+{
+    std::multimap<std::size_t, Costs::const_iterator> bySteps;
+    for (auto it = costs.begin(); it != costs.end(); ++it)
+        bySteps.insert(std::make_pair(it->second.steps, it));
+
+    std::list<std::string> lines;
+    unsigned int count = 0;
+    for (auto it = bySteps.rbegin(); it != bySteps.rend(); ++it, ++count) {
+        const Cost &c = it->second->second;
+        if (count >= 5U && c.bailouts.empty())
+            continue;
+        std::ostringstream ostr;
+        ostr << "ValueFlow: " << it->second->first << ": " << c.steps << " steps, " << c.values << " values";
+        for (auto bailout = c.bailouts.begin(); bailout != c.bailouts.end(); ++bailout)
+            ostr << (bailout == c.bailouts.begin() ? ", bailouts: " : ", ") << *bailout;
+        lines.push_back(ostr.str());
+        for (auto reason = c.reasons.begin(); reason != c.reasons.end(); ++reason)
+            lines.push_back("ValueFlow: " + it->second->first + ": bailout: " + *reason);
+    }
+    return lines;
 }
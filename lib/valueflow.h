@@ -21,6 +21,11 @@
 #define valueflowH
 //---------------------------------------------------------------------------
 
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+
 class Token;
 class TokenList;
 class ErrorLogger;
@@ -54,7 +59,34 @@ namespace ValueFlow {
         bool inconclusive;
     };
 
-    void setValues(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings);
+    /** Cost of the value flow analysis of a function, collected for --showtime */
+    struct Cost {
+        Cost() : steps(0), values(0) {}
+
+        std::size_t steps;
+        std::size_t values;
+
+        /** the budgets that were exhausted */
+        std::set<std::string> bailouts;
+
+        /** the reasons of the other bailouts, see --debug-warnings */
+        std::set<std::string> reasons;
+    };
+
+    /** Costs by function, the key is "name [file:line]" */
+    typedef std::map<std::string, Cost> Costs;
+
+    /**
+     * Set the values of the tokens
+     * @param tokenlist tokens
+     * @param errorLogger error logger for bailout messages
+     * @param settings settings
+     * @param costs if not null, the costs of the functions are added here
+     */
+    void setValues(TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, Costs *costs = nullptr);
+
+    /** Report lines for the 5 most expensive functions and every function where a budget was exhausted, with their bailout reasons */
+    std::list<std::string> costReport(const Costs &costs);
 }
 
 #endif // valueflowH
@@ -222,6 +222,7 @@ private:
         TEST_CASE(buffer_overrun_28); // Out of bound char array access
         TEST_CASE(buffer_overrun_bailoutIfSwitch);  // ticket #2378 : bailoutIfSwitch
         TEST_CASE(buffer_overrun_function_array_argument);
+        TEST_CASE(buffer_overrun_local_arrays);
         TEST_CASE(possible_buffer_overrun_1); // #3035
 
         TEST_CASE(valueflow_string); // using ValueFlow string values in checking
@@ -2871,6 +2872,27 @@ private:
         ASSERT_EQUALS("", errout.str());
     }
 
+    void buffer_overrun_local_arrays() {
+        check("void f(char *s) {\n"
+              "    char a[10];\n"
+              "    char b[5];\n"
+              "    strcpy(b, s);\n"
+              "    a[10] = 0;\n"
+              "    strcpy(b, \"abcdef\");\n"
+              "    dostuff(s, a);\n"
+              "}");
+        ASSERT_EQUALS("[test.cpp:5]: (error) Array 'a[10]' accessed at index 10, which is out of bounds.\n"
+                      "[test.cpp:6]: (error) Buffer is accessed out of bounds: b\n", errout.str());
+
+        check("void f(char b[5]) {\n"
+              "    { strcpy(b, \"abcdef\"); }\n"
+              "    char a[2] = { 0 };\n"
+              "    a[2] = 0;\n"
+              "}");
+        ASSERT_EQUALS("[test.cpp:2]: (error) Buffer is accessed out of bounds: b\n"
+                      "[test.cpp:4]: (error) Array 'a[2]' accessed at index 2, which is out of bounds.\n", errout.str());
+    }
+
     void possible_buffer_overrun_1() { // #3035
         check("void foo() {\n"
               "    char * data = alloca(50);\n"
@@ -0,0 +1,249 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2015 Daniel Marjamäki and Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "check.h"
+#include "tokenize.h"
+#include "settings.h"
+#include "mathlib.h"
+#include "testsuite.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/** Check that writes the tokens that its handlers are called for to a log */
+class LoggingCheck : public Check {
+public:
+    LoggingCheck(const Tokenizer *tokenizer, const Settings *settings, std::string &log)
+        : Check("Logging", tokenizer, settings, nullptr), _log(log) {
+    }
+
+    void runSimplifiedChecks(const Tokenizer *, const Settings *, ErrorLogger *) {
+    }
+    void getErrorMessages(ErrorLogger *, const Settings *) const {
+    }
+    std::string classInfo() const {
+        return "";
+    }
+
+    void byType(const Token *tok) {
+        log("type", tok);
+    }
+    void byStr(const Token *tok) {
+        log("str", tok);
+    }
+    void byStr2(const Token *tok) {
+        log("str2", tok);
+    }
+    void inFunctionBody(const Token *tok) {
+        log("body", tok);
+    }
+
+private:
+    void log(const char handler[], const Token *tok) {
+        std::ostringstream ostr;
+        ostr << handler << ':' << tok->str() << ':' << tok->linenr() << ' ';
+        _log += ostr.str();
+    }
+
+    std::string &_log;
+};
+
+
+/** Logger that collects the output of a ParallelLoop */
+class LoopLogger : public ErrorLogger {
+public:
+    std::string out;
+
+    void reportOut(const std::string &outmsg) {
+        out += outmsg + ' ';
+    }
+    void reportErr(const ErrorLogger::ErrorMessage &) {
+    }
+};
+
+
+/** Body that reports its index and the output that was passed on before it */
+class ReportingBody : public ParallelLoop::Body {
+public:
+    ReportingBody(ParallelLoop &loop, const LoopLogger &logger, std::size_t n, std::size_t throwAt)
+        : seen(n), _loop(loop), _logger(logger), _throwAt(throwAt) {
+    }
+
+    /** output that was passed on when each index started */
+    std::vector<std::string> seen;
+
+    void run(std::size_t i) {
+        // the first indexes are slowest, so they finish last when run in parallel
+        if (i < 2U)
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        seen[i] = _logger.out;
+        _loop.reportOut(MathLib::toString(i));
+        if (i == _throwAt)
+            throw InternalError(nullptr, "index " + MathLib::toString(i));
+        _loop.reportOut(MathLib::toString(i) + "b");
+    }
+
+private:
+    ParallelLoop &_loop;
+    const LoopLogger &_logger;
+    const std::size_t _throwAt;
+};
+
+
+class TestCheck : public TestFixture {
+public:
+    TestCheck() : TestFixture("TestCheck") {
+    }
+
+private:
+
+    void run() {
+        TEST_CASE(dispatcherOrder);
+        TEST_CASE(dispatcherFunctionBodies);
+
+        TEST_CASE(parallelLoopThreads);
+        TEST_CASE(parallelLoopOrder);
+        TEST_CASE(parallelLoopException);
+        TEST_CASE(parallelLoopSerial);
+    }
+
+    std::string dispatch(const char code[], void (*subscribe)(TokenDispatcher &, LoggingCheck *)) {
+        Settings settings;
+        Tokenizer tokenizer(&settings, this);
+        std::istringstream istr(code);
+        tokenizer.tokenize(istr, "test.cpp");
+
+        std::string log;
+        LoggingCheck check(&tokenizer, &settings, log);
+        TokenDispatcher dispatcher;
+        subscribe(dispatcher, &check);
+        dispatcher.run(&tokenizer);
+        return log;
+    }
+
+    static void subscribeOrder(TokenDispatcher &dispatcher, LoggingCheck *check) {
+        dispatcher.subscribe("==", check, &LoggingCheck::byStr2, "byStr2");
+        dispatcher.subscribe("==", check, &LoggingCheck::byStr, "byStr");
+        dispatcher.subscribe(Token::eComparisonOp, check, &LoggingCheck::byType, "byType");
+    }
+
+    void dispatcherOrder() {
+        // type handlers are called before string handlers, both in subscription order
+        ASSERT_EQUALS("type:==:2 str2:==:2 str:==:2 "
+                      "type:!=:3 ",
+                      dispatch("void f(int x) {\n"
+                               "    if (x == 1) {}\n"
+                               "    if (x != 2) {}\n"
+                               "}", subscribeOrder));
+    }
+
+    static void subscribeFunctionBodies(TokenDispatcher &dispatcher, LoggingCheck *check) {
+        dispatcher.subscribe("=", check, &LoggingCheck::inFunctionBody, "inFunctionBody", TokenDispatcher::FUNCTION_BODIES);
+        dispatcher.subscribe("=", check, &LoggingCheck::byStr, "byStr");
+    }
+
+    void dispatcherFunctionBodies() {
+        ASSERT_EQUALS("str:=:1 "
+                      "body:=:3 str:=:3 "
+                      "str:=:5 "
+                      "body:=:7 str:=:7 ",
+                      dispatch("int x = 1;\n"
+                               "void f() {\n"
+                               "    if (x) { x = 2; }\n"
+                               "}\n"
+                               "int y = 3;\n"
+                               "class C {\n"
+                               "    void g() { x = 4; }\n"
+                               "};", subscribeFunctionBodies));
+    }
+
+    void parallelLoopThreads() const {
+        ASSERT_EQUALS(1U, ParallelLoop::threads(nullptr));
+
+        Settings settings;
+        settings.checkThreads = 4;
+        ASSERT_EQUALS(4U, ParallelLoop::threads(&settings));
+
+        // the output of these options bypasses the loop
+        settings.debug = true;
+        ASSERT_EQUALS(1U, ParallelLoop::threads(&settings));
+        settings.debug = false;
+        settings.debugwarnings = true;
+        ASSERT_EQUALS(1U, ParallelLoop::threads(&settings));
+        settings.debugwarnings = false;
+        settings.checkLibrary = true;
+        ASSERT_EQUALS(1U, ParallelLoop::threads(&settings));
+        settings.checkLibrary = false;
+        settings._showtime = SHOWTIME_SUMMARY;
+        ASSERT_EQUALS(1U, ParallelLoop::threads(&settings));
+    }
+
+    void parallelLoopOrder() const {
+        // The output is buffered and passed on in index order
+        Settings settings;
+        settings.checkThreads = 4;
+        LoopLogger logger;
+        ParallelLoop loop(&logger, &settings);
+        ReportingBody body(loop, logger, 6, 8);
+        loop.forEach(6, body);
+        ASSERT_EQUALS("0 0b 1 1b 2 2b 3 3b 4 4b 5 5b ", logger.out);
+        ASSERT_EQUALS("", body.seen[0] + body.seen[1] + body.seen[5]);
+
+        // Outside of forEach() the output is passed on directly
+        loop.reportOut("after");
+        ASSERT_EQUALS("0 0b 1 1b 2 2b 3 3b 4 4b 5 5b after ", logger.out);
+    }
+
+    void parallelLoopException() const {
+        // Same output as a serial loop: the exception is rethrown after the
+        // output of the index that threw it
+        Settings settings;
+        settings.checkThreads = 4;
+        LoopLogger logger;
+        ParallelLoop loop(&logger, &settings);
+        ReportingBody body(loop, logger, 6, 3);
+        std::string error;
+        try {
+            loop.forEach(6, body);
+        } catch (const InternalError &e) {
+            error = e.errorMessage;
+        }
+        ASSERT_EQUALS("index 3", error);
+        ASSERT_EQUALS("0 0b 1 1b 2 2b 3 ", logger.out);
+    }
+
+    void parallelLoopSerial() const {
+        // With one thread the bodies run in order and pass on their output directly
+        Settings settings;
+        settings.checkThreads = 1;
+        LoopLogger logger;
+        ParallelLoop loop(&logger, &settings);
+        ReportingBody body(loop, logger, 4, 2);
+        ASSERT_THROW(loop.forEach(4, body), InternalError);
+        ASSERT_EQUALS("0 0b 1 1b 2 ", logger.out);
+        ASSERT_EQUALS("0 0b ", body.seen[1]);
+        ASSERT_EQUALS("0 0b 1 1b ", body.seen[2]);
+    }
+};
+
+REGISTER_TEST(TestCheck)
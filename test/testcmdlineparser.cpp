@@ -92,6 +92,15 @@ private:
         TEST_CASE(maxConfigsMissingCount);
         TEST_CASE(maxConfigsInvalid);
         TEST_CASE(maxConfigsTooSmall);
+        TEST_CASE(maxTemplateInstantiations);
+        TEST_CASE(maxTemplateInstantiationsInvalid);
+        TEST_CASE(valueFlowMaxValues);
+        TEST_CASE(valueFlowMaxSteps);
+        TEST_CASE(valueFlowMaxStepsInvalid);
+        TEST_CASE(checkThreads);
+        TEST_CASE(checkThreadsInvalid);
+        TEST_CASE(libraryCache);
+        TEST_CASE(libraryCacheMissing);
         TEST_CASE(reportProgressTest); // "Test" suffix to avoid hiding the parent's reportProgress
         TEST_CASE(stdposix);
         TEST_CASE(stdc99);
@@ -671,6 +680,74 @@ private:
         ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
     }
 
+    void maxTemplateInstantiations() {
+        REDIRECT;
+        const char *argv[] = {"seccheck", "--max-template-instantiations=100", "file.cpp"};
+        settings.maxTemplateInstantiations = 0;
+        ASSERT(defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(100, settings.maxTemplateInstantiations);
+    }
+
+    void maxTemplateInstantiationsInvalid() {
+        REDIRECT;
+        const char *argv[] = {"seccheck", "--max-template-instantiations=e", "file.cpp"};
+        // Fails since invalid count given for --max-template-instantiations=
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
+    }
+
+    void valueFlowMaxValues() {
+        REDIRECT;
+        const char *argv[] = {"seccheck", "--valueflow-max-values=20", "file.cpp"};
+        settings.valueFlowMaxValues = 0;
+        ASSERT(defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(20, settings.valueFlowMaxValues);
+    }
+
+    void valueFlowMaxSteps() {
+        REDIRECT;
+        const char *argv[] = {"seccheck", "--valueflow-max-steps=1000", "file.cpp"};
+        settings.valueFlowMaxSteps = 0;
+        ASSERT(defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(1000, settings.valueFlowMaxSteps);
+    }
+
+    void valueFlowMaxStepsInvalid() {
+        REDIRECT;
+        const char *argv[] = {"seccheck", "--valueflow-max-steps=e", "file.cpp"};
+        // Fails since invalid count given for --valueflow-max-steps=
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
+    }
+
+    void checkThreads() {
+        REDIRECT;
+        const char *argv[] = {"seccheck", "--check-threads=4", "file.cpp"};
+        settings.checkThreads = 1;
+        ASSERT(defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(4, settings.checkThreads);
+    }
+
+    void checkThreadsInvalid() {
+        REDIRECT;
+        const char *argv[] = {"seccheck", "--check-threads=0", "file.cpp"};
+        // Fails since at least one thread is needed
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
+    }
+
+    void libraryCache() {
+        REDIRECT;
+        const char *argv[] = {"seccheck", "--library-cache=.", "file.cpp"};
+        ASSERT(defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(".", settings.library.cachedir());
+        settings.library.setcachedir("");
+    }
+
+    void libraryCacheMissing() {
+        REDIRECT;
+        const char *argv[] = {"seccheck", "--library-cache=nonexistent-directory", "file.cpp"};
+        // Fails since the directory does not exist
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
+    }
+
     void reportProgressTest() {
         REDIRECT;
         const char *argv[] = {"seccheck", "--report-progress", "file.cpp"};
@@ -401,6 +401,16 @@ private:
               "  else if (dynamic_cast<LABEL*>(widget)){}\n"
               "}",false);
         ASSERT_EQUALS("", errout.str());
+
+        check("void f(int a, int b, int &c) {\n"
+              "    if (a == b) { c = 1; }\n"
+              "    else if (a == 1) { c = 2; }\n"
+              "    else if (b == 2) { c = 3; }\n"
+              "    else if (b == a) { c = 4; }\n"
+              "    else if (a == 1) { c = 5; }\n"
+              "}");
+        ASSERT_EQUALS("[test.cpp:5]: (style) Expression is always false because 'else if' condition matches previous condition at line 2.\n"
+                      "[test.cpp:6]: (style) Expression is always false because 'else if' condition matches previous condition at line 3.\n", errout.str());
     }
 
     void invalidMissingSemicolon() {
@@ -178,6 +178,8 @@ private:
         TEST_CASE(uninitConstVar);
         TEST_CASE(constructors_crash1);    // ticket #5641
         TEST_CASE(invalidInitializerList); // ticket #5702
+
+        TEST_CASE(memberFunctionUsage);
     }
 
 
@@ -3130,6 +3132,29 @@ private:
                            "  R1 () : a { }\n"
                            "};\n"), InternalError);
     }
+
+    void memberFunctionUsage() {
+        // The usage of init() is parsed once and used for both constructors
+        check("class Fred {\n"
+              "    int x, y;\n"
+              "    void init() { x = 0; }\n"
+              "public:\n"
+              "    Fred() { init(); }\n"
+              "    Fred(int) { init(); y = 0; }\n"
+              "};");
+        ASSERT_EQUALS("[test.cpp:5]: (warning) Member variable 'Fred::y' is not initialized in the constructor.\n", errout.str());
+
+        // Recursion: the usage depends on the caller
+        check("class Fred {\n"
+              "    int x;\n"
+              "    void f() { g(); }\n"
+              "    void g() { f(); }\n"
+              "public:\n"
+              "    Fred() { f(); }\n"
+              "    Fred(int) { g(); }\n"
+              "};");
+        ASSERT_EQUALS("", errout.str());
+    }
 };
 
 REGISTER_TEST(TestConstructors)
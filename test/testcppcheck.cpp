@@ -22,6 +22,7 @@
 #include "testsuite.h"
 #include "path.h"
 #include "check.h"
+#include "mathlib.h"
 
 #include <algorithm>
 #include <list>
@@ -46,6 +47,12 @@ private:
 
         void reportErr(const ErrorLogger::ErrorMessage &msg) {
             id.push_back(msg._id);
+            severities |= Check::severityBit(msg._severity);
+        }
+
+        unsigned int severities;
+
+        ErrorLogger2() : severities(0) {
         }
     };
 
@@ -53,6 +60,8 @@ private:
         TEST_CASE(instancesSorted);
         TEST_CASE(classInfoFormat);
         TEST_CASE(getErrorMessages);
+        TEST_CASE(declaredSeverities);
+        TEST_CASE(checkThreads);
     }
 
     void instancesSorted() const {
@@ -95,6 +104,58 @@ private:
         }
         ASSERT_EQUALS("", duplicate);
     }
+
+    void declaredSeverities() const {
+        // Checks that declare their severities must not report anything else
+        const Settings settings;
+        for (auto i = Check::instances().begin(); i != Check::instances().end(); ++i) {
+            const unsigned int declared = (*i)->severities();
+            if (declared == 0)
+                continue;
+            ErrorLogger2 errorLogger;
+            (*i)->getErrorMessages(&errorLogger, &settings);
+            ASSERT_EQUALS((*i)->name() + ": 0", (*i)->name() + ": " + MathLib::toString(errorLogger.severities & ~declared));
+        }
+    }
+
+    static std::list<std::string> checkWithThreads(unsigned int threads) {
+        // several functions and classes for each check that runs its parts in parallel
+        const char code[] = "struct S { int *p; };\n"
+                            "void f(int x) {\n"
+                            "    char buf[10];\n"
+                            "    int *p = malloc(10);\n"
+                            "    buf[10] = 0;\n"
+                            "    if (x == 1) { x = 0; } else if (x == 1) { x = 2; }\n"
+                            "    x = x / 0;\n"
+                            "    memset(buf, 0, 0);\n"
+                            "}\n"
+                            "void g1() { char *p = malloc(10); }\n"
+                            "void g2() { char *p = malloc(10); free(p); }\n"
+                            "void g3() { char *p = malloc(10); }\n"
+                            "int h1() { int x; return x; }\n"
+                            "int h2() { int x = 0; return x; }\n"
+                            "int h3() { int y; return y; }\n"
+                            "class A { int x; int a; public: A() { x = 0; } int get() { return x; } };\n"
+                            "class B { int x; public: B() { x = 0; } int get() { return x; } };\n"
+                            "class C { int c; public: C() { } int get() { return c; } };\n";
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.settings().addEnabled("warning,style,performance,portability");
+        cppCheck.settings().inconclusive = true;
+        cppCheck.settings().checkThreads = threads;
+        cppCheck.check("test.cpp", code);
+        return errorLogger.id;
+    }
+
+    void checkThreads() const {
+        // Concurrent checking reports the same errors in the same order
+        const std::list<std::string> serial = checkWithThreads(1);
+        ASSERT_EQUALS(3, std::count(serial.begin(), serial.end(), "memleak"));
+        ASSERT_EQUALS(2, std::count(serial.begin(), serial.end(), "uninitvar"));
+        ASSERT_EQUALS(2, std::count(serial.begin(), serial.end(), "uninitMemberVar"));
+        ASSERT_EQUALS(3, std::count(serial.begin(), serial.end(), "functionConst"));
+        ASSERT(serial == checkWithThreads(4));
+    }
 };
 
 REGISTER_TEST(TestCppcheck)
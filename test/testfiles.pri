@@ -10,6 +10,7 @@ SOURCES += $${BASEPATH}/test64bit.cpp \
            $${BASEPATH}/testboost.cpp \
            $${BASEPATH}/testbufferoverrun.cpp \
            $${BASEPATH}/testcharvar.cpp \
+           $${BASEPATH}/testcheck.cpp \
            $${BASEPATH}/testclass.cpp \
            $${BASEPATH}/testcmdlineparser.cpp \
            $${BASEPATH}/testcondition.cpp \
@@ -88,12 +88,24 @@ private:
         tokenizer.tokenize(istr, filename);
 
         // call all "runChecks" in all registered Check classes
+        {
+            TokenDispatcher dispatcher;
+            for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it)
+                (*it)->subscribe(dispatcher, Check::NORMAL, &tokenizer, &settings, this);
+            dispatcher.run(&tokenizer);
+        }
         for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it) {
             (*it)->runChecks(&tokenizer, &settings, this);
         }
 
         tokenizer.simplifyTokenList2();
         // call all "runSimplifiedChecks" in all registered Check classes
+        {
+            TokenDispatcher dispatcher;
+            for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it)
+                (*it)->subscribe(dispatcher, Check::SIMPLIFIED, &tokenizer, &settings, this);
+            dispatcher.run(&tokenizer);
+        }
         for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it) {
             (*it)->runSimplifiedChecks(&tokenizer, &settings, this);
         }
@@ -19,8 +19,21 @@
 #include "library.h"
 #include "token.h"
 #include "tokenlist.h"
+#include "filelister.h"
 #include "testsuite.h"
 #include <tinyxml2.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <direct.h>
+#define mkdir(path, mode) _mkdir(path)
+#define rmdir _rmdir
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 class TestLibrary : public TestFixture {
 public:
@@ -35,11 +48,15 @@ private:
         TEST_CASE(function_arg_any);
         TEST_CASE(function_arg_valid);
         TEST_CASE(function_arg_minsize);
+        TEST_CASE(function_descriptor);
         TEST_CASE(memory);
         TEST_CASE(memory2); // define extra "free" allocation functions
         TEST_CASE(resource);
         TEST_CASE(podtype);
         TEST_CASE(version);
+        TEST_CASE(image);
+        TEST_CASE(image_cfg);
+        TEST_CASE(image_cache);
     }
 
     void empty() const {
@@ -195,6 +212,69 @@ private:
         }
     }
 
+    void function_descriptor() const {
+        const char xmldata[] = "<?xml version=\"1.0\"?>\n"
+                               "<def>\n"
+                               "  <function name=\"foo\">\n"
+                               "    <noreturn>false</noreturn>\n"
+                               "    <formatstr scan=\"true\"/>\n"
+                               "    <arg nr=\"2\"><formatstr/><minsize type=\"strlen\" arg=\"3\"/></arg>\n"
+                               "    <arg nr=\"any\"><not-null/><valid>0:3</valid></arg>\n"
+                               "  </function>\n"
+                               "  <function name=\"bar\">\n"
+                               "    <noreturn>true</noreturn>\n"
+                               "  </function>\n"
+                               "</def>";
+        tinyxml2::XMLDocument doc;
+        doc.Parse(xmldata, sizeof(xmldata));
+
+        Library library;
+        library.load(doc);
+
+        ASSERT(library.descriptor("baz") == nullptr);
+        const Library::FunctionDescriptor *foo = library.descriptor("foo");
+        const Library::FunctionDescriptor *bar = library.descriptor("bar");
+        ASSERT(foo != nullptr && bar != nullptr);
+        if (!foo || !bar)
+            return;
+        ASSERT(foo == library.descriptor("foo"));
+        ASSERT(foo->id != bar->id);
+
+        ASSERT_EQUALS(false, foo->noreturn);
+        ASSERT_EQUALS(true, foo->notnoreturn);
+        ASSERT_EQUALS(true, bar->noreturn);
+        ASSERT_EQUALS(true, foo->formatstr);
+        ASSERT_EQUALS(true, foo->formatstr_scan);
+        ASSERT_EQUALS(false, foo->formatstr_secure);
+        ASSERT_EQUALS(2, foo->formatstrargnr);
+        ASSERT_EQUALS(true, foo->hasminsize);
+        ASSERT_EQUALS(false, bar->hasminsize);
+
+        // arg 2 is configured, the other arguments use "any"
+        ASSERT_EQUALS(false, foo->isnullargbad(2));
+        ASSERT_EQUALS(true, foo->isargformatstr(2));
+        ASSERT_EQUALS(true, foo->argminsizes(2) != nullptr);
+        ASSERT_EQUALS(true, foo->isnullargbad(1));
+        ASSERT_EQUALS(true, foo->isnullargbad(5));
+        ASSERT_EQUALS(true, foo->isargvalid(1, 3));
+        ASSERT_EQUALS(false, foo->isargvalid(1, 4));
+        ASSERT_EQUALS("0:3", foo->validarg(7));
+        ASSERT_EQUALS(true, foo->isargvalid(2, 4));
+        ASSERT(bar->arg(1) == nullptr);
+
+        // the name based queries use the same descriptors
+        ASSERT_EQUALS(true, library.isnullargbad("foo", 3));
+        ASSERT_EQUALS(true, library.isnoreturn("bar"));
+        ASSERT_EQUALS(true, library.isnotnoreturn("foo"));
+        ASSERT_EQUALS(false, library.isargvalid("foo", 1, -1));
+        ASSERT_EQUALS(true, library.formatstr_scan("foo"));
+        ASSERT_EQUALS(false, library.formatstr_scan("baz"));
+        ASSERT_EQUALS(false, library.formatstr_secure("baz"));
+
+        library.setnoreturn("baz", true);
+        ASSERT_EQUALS(true, library.isnoreturn("baz"));
+    }
+
     void memory() const {
         const char xmldata[] = "<?xml version=\"1.0\"?>\n"
                                "<def>\n"
@@ -311,6 +391,176 @@ private:
             ASSERT_EQUALS(err.errorcode, Library::UNSUPPORTED_FORMAT);
         }
     }
+
+    void image() const {
+        const char xmldata[] = "<?xml version=\"1.0\"?>\n"
+                               "<def>\n"
+                               "  <function name=\"foo\">\n"
+                               "    <noreturn>false</noreturn>\n"
+                               "    <leak-ignore/>\n"
+                               "    <arg nr=\"1\"><not-null/><valid>0:3</valid><minsize type=\"mul\" arg=\"2\" arg2=\"3\"/></arg>\n"
+                               "  </function>\n"
+                               "  <memory>\n"
+                               "    <alloc>CreateFoo</alloc>\n"
+                               "    <dealloc>DeleteFoo</dealloc>\n"
+                               "  </memory>\n"
+                               "  <podtype name=\"s16\" sizeof=\"2\" sign=\"s\"/>\n"
+                               "  <platformtype name=\"u8\" value=\"char\"><unsigned/></platformtype>\n"
+                               "  <define name=\"FOO\" value=\"1\"/>\n"
+                               "</def>";
+        Library library;
+        ASSERT_EQUALS(true, library.loadxmldata(xmldata, sizeof(xmldata)));
+
+        std::ostringstream ostr;
+        ASSERT_EQUALS(true, library.saveimage(ostr));
+
+        Library image;
+        std::istringstream istr(ostr.str());
+        ASSERT_EQUALS(true, image.loadimage(istr));
+
+        ASSERT_EQUALS(true, image.isnotnoreturn("foo"));
+        ASSERT_EQUALS(true, image.leakignore.find("foo") != image.leakignore.end());
+        ASSERT_EQUALS(true, image.isnullargbad("foo", 1));
+        ASSERT_EQUALS(false, image.isargvalid("foo", 1, 4));
+        ASSERT_EQUALS(true, image.argminsizes("foo", 1) != nullptr);
+        ASSERT_EQUALS(library.alloc("CreateFoo"), image.alloc("CreateFoo"));
+        ASSERT_EQUALS(library.alloc("CreateFoo"), image.dealloc("DeleteFoo"));
+        const struct Library::PodType *type = image.podtype("s16");
+        ASSERT_EQUALS(2U, type ? type->size : 0U);
+        ASSERT_EQUALS('s', type ? type->sign : '?');
+        const Library::PlatformType *ptype = image.platform_type("u8", "");
+        ASSERT_EQUALS(true, ptype && ptype->_unsigned);
+        ASSERT_EQUALS(1U, image.defines.size());
+
+        // the image holds all of the configuration
+        std::ostringstream ostr2;
+        ASSERT_EQUALS(true, image.saveimage(ostr2));
+        ASSERT_EQUALS(true, ostr.str() == ostr2.str());
+
+        // a truncated image is rejected and the configuration is kept
+        std::istringstream truncated(ostr.str().substr(0, ostr.str().size() / 2));
+        ASSERT_EQUALS(false, image.loadimage(truncated));
+        ASSERT_EQUALS(true, image.isnotnoreturn("foo"));
+
+        std::istringstream garbage("seccheck");
+        ASSERT_EQUALS(false, image.loadimage(garbage));
+    }
+
+    void image_cfg() {
+        Library library;
+        LOAD_LIB_2(library, "std.cfg");
+        LOAD_LIB_2(library, "windows.cfg");
+        LOAD_LIB_2(library, "qt.cfg");
+
+        std::ostringstream ostr;
+        ASSERT_EQUALS(true, library.saveimage(ostr));
+
+        Library image;
+        std::istringstream istr(ostr.str());
+        ASSERT_EQUALS(true, image.loadimage(istr));
+        ASSERT_EQUALS(true, image.isnoreturn("exit"));
+        ASSERT_EQUALS(true, image.markupFile("test.qml"));
+
+        std::ostringstream ostr2;
+        ASSERT_EQUALS(true, image.saveimage(ostr2));
+        ASSERT_EQUALS(true, ostr.str() == ostr2.str());
+    }
+
+    static void writeFile(const std::string &filename, const std::string &data) {
+        std::ofstream fout(filename.c_str(), std::ios::binary);
+        fout << data;
+    }
+
+    static std::string readFile(const std::string &filename) {
+        std::ifstream fin(filename.c_str(), std::ios::binary);
+        std::ostringstream ostr;
+        ostr << fin.rdbuf();
+        return ostr.str();
+    }
+
+    /** names of the images in the cache folder */
+    static std::vector<std::string> images(const std::string &cachedir) {
+        std::map<std::string, std::size_t> files;
+        std::set<std::string> extra;
+        extra.insert(".bin");
+        FileLister::recursiveAddFiles(files, cachedir, extra);
+        std::vector<std::string> names;
+        for (std::map<std::string, std::size_t>::const_iterator it = files.begin(); it != files.end(); ++it)
+            names.push_back(it->first);
+        return names;
+    }
+
+    static std::string cfg(const char noreturn[]) {
+        return std::string("<?xml version=\"1.0\"?>\n"
+                           "<def>\n"
+                           "  <function name=\"cached1\"><noreturn>") + noreturn + "</noreturn></function>\n"
+               "</def>";
+    }
+
+    void image_cache() {
+        const std::string cachedir("testlibrary-cache");
+        const std::string cfgfile(cachedir + "/test.cfg");
+        mkdir(cachedir.c_str(), 0700);
+        writeFile(cfgfile, cfg("false"));
+
+        // The first load writes an image
+        {
+            Library library;
+            library.setcachedir(cachedir);
+            ASSERT_EQUALS(Library::OK, library.load(nullptr, cfgfile.c_str()).errorcode);
+            ASSERT_EQUALS(true, library.isnotnoreturn("cached1"));
+        }
+        std::vector<std::string> imagefiles = images(cachedir);
+        ASSERT_EQUALS(1U, imagefiles.size());
+        if (imagefiles.size() != 1U)
+            return;
+        const std::string imagefile(imagefiles[0]);
+
+        // The next load reads the image. It is changed to tell it from the xml.
+        std::string image = readFile(imagefile);
+        for (std::string::size_type pos = image.find("cached1"); pos != std::string::npos; pos = image.find("cached1", pos))
+            image[pos + 6U] = '2';
+        writeFile(imagefile, image);
+        {
+            Library library;
+            library.setcachedir(cachedir);
+            ASSERT_EQUALS(Library::OK, library.load(nullptr, cfgfile.c_str()).errorcode);
+            ASSERT_EQUALS(true, library.isnotnoreturn("cached2"));
+            ASSERT_EQUALS(false, library.isnotnoreturn("cached1"));
+        }
+
+        // An edited configuration file gets a new image
+        writeFile(cfgfile, cfg("true"));
+        {
+            Library library;
+            library.setcachedir(cachedir);
+            ASSERT_EQUALS(Library::OK, library.load(nullptr, cfgfile.c_str()).errorcode);
+            ASSERT_EQUALS(true, library.isnoreturn("cached1"));
+        }
+        imagefiles = images(cachedir);
+        ASSERT_EQUALS(2U, imagefiles.size());
+
+        // A corrupt image is ignored, the xml is loaded and the image is written again
+        writeFile(imagefile, "seccheck");
+        writeFile(cfgfile, cfg("false"));
+        {
+            Library library;
+            library.setcachedir(cachedir);
+            ASSERT_EQUALS(Library::OK, library.load(nullptr, cfgfile.c_str()).errorcode);
+            ASSERT_EQUALS(true, library.isnotnoreturn("cached1"));
+        }
+        {
+            Library library;
+            std::istringstream istr(readFile(imagefile));
+            ASSERT_EQUALS(true, library.loadimage(istr));
+            ASSERT_EQUALS(true, library.isnotnoreturn("cached1"));
+        }
+
+        for (std::size_t i = 0; i < imagefiles.size(); ++i)
+            std::remove(imagefiles[i].c_str());
+        std::remove(cfgfile.c_str());
+        rmdir(cachedir.c_str());
+    }
 };
 
 REGISTER_TEST(TestLibrary)
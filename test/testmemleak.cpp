@@ -365,6 +365,9 @@ private:
 
         TEST_CASE(ptrptr);
 
+        // statements that only use other variables are skipped
+        TEST_CASE(skipStatements);
+
         // test that the cfg files are configured correctly
         TEST_CASE(posixcfg);
         TEST_CASE(posixcfg_mmap);
@@ -4244,6 +4247,23 @@ private:
         ASSERT_EQUALS("[test.cpp:5]: (error) Memory leak: p\n", errout.str());
     }
 
+    void skipStatements() {
+        check("void f(int x) {\n"
+              "    char *a = malloc(10);\n"
+              "    char *b = malloc(10);\n"
+              "    memset(a, 0, 10);\n"
+              "    if (x > 0) {\n"
+              "        strcpy(b, \"abc\");\n"
+              "        free(a);\n"
+              "        return;\n"
+              "    }\n"
+              "    memset(b, 0, 10);\n"
+              "    free(b);\n"
+              "}");
+        ASSERT_EQUALS("[test.cpp:12]: (error) Memory leak: a\n"
+                      "[test.cpp:8]: (error) Memory leak: b\n", errout.str());
+    }
+
     // Test that posix.cfg is configured correctly
     void posixcfg() {
         Settings settings;
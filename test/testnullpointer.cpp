@@ -2280,6 +2280,7 @@ private:
             Library::ArgumentChecks arg;
             library.argumentChecks["x"][1] = arg;
             library.argumentChecks["x"][2] = arg;
+            library.resolveFunctions();
 
             std::list<const Token *> null, uninit;
             CheckNullPointer::parseFunctionCall(*xtok, null, &library, 0U);
@@ -2295,6 +2296,7 @@ private:
             library.argumentChecks["x"][1] = arg;
             library.argumentChecks["x"][2] = arg;
             library.argumentChecks["x"][1].notnull = true;
+            library.resolveFunctions();
 
             std::list<const Token *> null,uninit;
             CheckNullPointer::parseFunctionCall(*xtok, null, &library, 0U);
@@ -2311,6 +2313,7 @@ private:
             library.argumentChecks["x"][1] = arg;
             library.argumentChecks["x"][2] = arg;
             library.argumentChecks["x"][2].notuninit = true;
+            library.resolveFunctions();
 
             std::list<const Token *> null,uninit;
             CheckNullPointer::parseFunctionCall(*xtok, null, &library, 0U);
@@ -203,6 +203,11 @@ private:
 
         // Check..
         CheckOther checkOther(&tokenizer, settings, this);
+        {
+            TokenDispatcher dispatcher;
+            checkOther.subscribe(dispatcher, Check::NORMAL, &tokenizer, settings, this);
+            dispatcher.run(&tokenizer);
+        }
         checkOther.runChecks(&tokenizer, settings, this);
 
         if (runSimpleChecks) {
@@ -211,6 +216,9 @@ private:
             const std::string str2(tokenizer.tokens()->stringifyList(0,true));
             if (str1 != str2)
                 warnUnsimplified(str1, str2);
+            TokenDispatcher dispatcher;
+            checkOther.subscribe(dispatcher, Check::SIMPLIFIED, &tokenizer, settings, this);
+            dispatcher.run(&tokenizer);
             checkOther.runSimplifiedChecks(&tokenizer, settings, this);
         }
     }
@@ -86,6 +86,7 @@ private:
         TEST_CASE(template49);  // #6237 - template instantiation
         TEST_CASE(template50);  // #4272 - simple partial specialization
         TEST_CASE(template51);  // #6172 - crash upon valid code
+        TEST_CASE(template_instantiation_budget);
         TEST_CASE(template_unhandled);
         TEST_CASE(template_default_parameter);
         TEST_CASE(template_default_type);
@@ -929,6 +930,27 @@ private:
             "}");
     }
 
+    void template_instantiation_budget() {
+        const char code[] = "template <class T> struct Fred { T a; };\n"
+                            "Fred<int> fred1;\n"
+                            "Fred<char> fred2;";
+
+        errout.str("");
+
+        Settings settings;
+        settings.maxTemplateInstantiations = 1;
+        Tokenizer tokenizer(&settings, this);
+
+        std::istringstream istr(code);
+        tokenizer.tokenize(istr, "test.cpp");
+
+        // Only the first instantiation is expanded
+        const std::string expected("Fred<int> fred1 ; "
+                                   "Fred < char > fred2 ; "
+                                   "struct Fred<int> { int a ; } ;");
+        ASSERT_EQUALS(expected, tokenizer.tokens()->stringifyList(0, false));
+    }
+
     void template_default_parameter() {
         {
             const char code[] = "template <class T, int n=3>\n"
@@ -86,6 +86,7 @@ private:
         TEST_CASE(pushback10);
         TEST_CASE(pushback11);
         TEST_CASE(pushback12);
+        TEST_CASE(pushback13);
         TEST_CASE(insert1);
         TEST_CASE(insert2);
 
@@ -1241,6 +1242,27 @@ private:
                       "[test.cpp:9]: (error) After insert(), the iterator 'it' may be invalid.\n", errout.str());
     }
 
+    void pushback13() {
+        // several iterators and pointers tracked in the same function
+        check("void f(std::vector<int> &v, std::list<int> &l1, std::list<int> &l2)\n"
+              "{\n"
+              "    std::vector<int>::iterator a = v.begin();\n"
+              "    int *p = &v[0];\n"
+              "    std::list<int>::iterator b;\n"
+              "    v.push_back(1);\n"
+              "    *p = 0;\n"
+              "    *a = 0;\n"
+              "    for (b = l1.begin(); b != l2.end(); ++b) { }\n"
+              "    std::list<int>::iterator c = l1.begin();\n"
+              "    l1.erase(c);\n"
+              "    *c = 0;\n"
+              "}");
+        ASSERT_EQUALS("[test.cpp:9]: (error) Same iterator is used with different containers 'l1' and 'l2'.\n"
+                      "[test.cpp:12] -> [test.cpp:11]: (error) Iterator 'c' used after element has been erased.\n"
+                      "[test.cpp:7]: (error) Invalid pointer 'p' after push_back().\n"
+                      "[test.cpp:8]: (error) After push_back(), the iterator 'a' may be invalid.\n", errout.str());
+    }
+
     void insert1() {
         check("void f(std::vector<int> &ints)\n"
               "{\n"
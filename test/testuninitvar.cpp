@@ -67,6 +67,7 @@ private:
         TEST_CASE(uninitvar2_while);
         TEST_CASE(uninitvar2_4494);      // #4494
         TEST_CASE(uninitvar2_malloc);    // malloc returns uninitialized data
+        TEST_CASE(uninitvar2_statements); // statements that don't use the variable are skipped
         TEST_CASE(uninitvar7); // ticket #5971
         TEST_CASE(uninitvar8); // ticket #6230
 
@@ -3588,6 +3589,31 @@ private:
         ASSERT_EQUALS("", errout.str());
     }
 
+    void uninitvar2_statements() {
+        checkUninitVar2("struct AB { int a; int b; };\n"
+                        "void f(int *p) {\n"
+                        "    int x, y;\n"
+                        "    struct AB ab;\n"
+                        "    p[0] = 1;\n"
+                        "    p[1] = p[0];\n"
+                        "    ab.b = 0;\n"
+                        "    y = p[0] + p[1];\n"
+                        "    p[2] = x + y + ab.a;\n"
+                        "}");
+        ASSERT_EQUALS("[test.cpp:9]: (error) Uninitialized variable: x\n"
+                      "[test.cpp:9]: (error) Uninitialized struct member: ab.a\n", errout.str());
+
+        // the value of y is known (not zero)
+        checkUninitVar2("void f(int *p, int a) {\n"
+                        "    int x, y;\n"
+                        "    y = - a;\n"
+                        "    p[1] = 0;\n"
+                        "    if (y) { x = 0; }\n"
+                        "    p[2] = x;\n"
+                        "}");
+        ASSERT_EQUALS("", errout.str());
+    }
+
     void syntax_error() { // Ticket #5073
         // Nominal mode => No output
         checkUninitVar2("struct flex_array {};\n"
@@ -133,6 +133,7 @@ private:
         TEST_CASE(localvarStruct3);
         TEST_CASE(localvarStruct5);
         TEST_CASE(localvarStruct6);
+        TEST_CASE(localvarStruct7);
         TEST_CASE(localvarStructArray);
 
         TEST_CASE(localvarOp);          // Usage with arithmetic operators
@@ -3024,6 +3025,25 @@ private:
         ASSERT_EQUALS("", errout.str());
     }
 
+    void localvarStruct7() {
+        // The declarations of a block share the result of the struct lookup
+        functionVariableUsage("void f() {\n"
+                              "    int a;\n"
+                              "    struct S { int x; int y; };\n"
+                              "    int b;\n"
+                              "    for (int i = 0; i < 10; i++) {\n"
+                              "        int c;\n"
+                              "        int d;\n"
+                              "    }\n"
+                              "    int e;\n"
+                              "}");
+        ASSERT_EQUALS("[test.cpp:2]: (style) Unused variable: a\n"
+                      "[test.cpp:4]: (style) Unused variable: b\n"
+                      "[test.cpp:6]: (style) Unused variable: c\n"
+                      "[test.cpp:7]: (style) Unused variable: d\n"
+                      "[test.cpp:9]: (style) Unused variable: e\n", errout.str());
+    }
+
     void localvarStructArray() {
         // #3633 - detect that struct array is assigned a value
         functionVariableUsage("void f() {\n"
@@ -62,6 +62,9 @@ private:
         TEST_CASE(valueFlowForLoop);
         TEST_CASE(valueFlowSubFunction);
         TEST_CASE(valueFlowFunctionReturn);
+
+        TEST_CASE(valueFlowBudget);
+        TEST_CASE(valueFlowCostReport);
     }
 
     bool testValueOfX(const char code[], unsigned int linenr, int value) {
@@ -147,6 +150,15 @@ private:
         return values.size() == 1U && !values.front().tokvalue ? values.front() : ValueFlow::Value();
     }
 
+    std::list<ValueFlow::Value> tokenValues(const char code[], const char tokstr[], const Settings &settings) {
+        Tokenizer tokenizer(&settings, this);
+        std::istringstream istr(code);
+        errout.str("");
+        tokenizer.tokenize(istr, "test.cpp");
+        const Token *tok = Token::findmatch(tokenizer.tokens(), tokstr);
+        return tok ? tok->values : std::list<ValueFlow::Value>();
+    }
+
     void valueFlowNumber() {
         const char *code;
 
@@ -614,6 +626,15 @@ private:
                "}";
         ASSERT_EQUALS(true, testValueOfX(code, 3U, 123));
 
+        code = "void f() {\n"
+               "    int x = 123;\n"
+               "    a = 1;\n"
+               "    if (b) { c = 2; }\n"
+               "    while (d) { e(); }\n"
+               "    return x;\n"
+               "}";
+        ASSERT_EQUALS(true, testValueOfX(code, 6U, 123));
+
         code = "void f() {\n"
                "    int x = 9;\n"
                "    --x;\n"
@@ -1306,6 +1327,14 @@ private:
                "}";
         ASSERT_EQUALS(true, testValueOfX(code, 1U, 123));
 
+        code = "void f1(int x) { a = x; }\n"
+               "void f2() {\n"
+               "    f1(1);\n"
+               "    f1(2);\n"
+               "}";
+        ASSERT_EQUALS(true, testValueOfX(code, 1U, 1));
+        ASSERT_EQUALS(true, testValueOfX(code, 1U, 2));
+
         code = "void f1(int x) { return x; }\n"
                "void f2(int x) {\n"
                "    f1(x);\n"
@@ -1384,6 +1413,79 @@ private:
                "    x = 1 * add(10+1,4);\n"
                "}";
         ASSERT_EQUALS(15, valueOfTok(code, "*").intvalue);
+
+        code = "void f1(int x) {\n"
+               "  return x+1;\n"
+               "}\n"
+               "void f2() {\n"
+               "    x = f1(2) - 1;\n"
+               "    y = f1(2) * 2;\n"
+               "}";
+        ASSERT_EQUALS(2, valueOfTok(code, "-").intvalue);
+        ASSERT_EQUALS(6, valueOfTok(code, "*").intvalue);
+    }
+
+    void valueFlowBudget() {
+        const char code[] = "void f(int x) {\n"
+                            "    a = x;\n"
+                            "    if (x == 0) {}\n"
+                            "    if (x == 5) {}\n"
+                            "}";
+        Settings settings;
+        ASSERT_EQUALS(2U, tokenValues(code, "x ;", settings).size());
+
+        // max values per token
+        settings.valueFlowMaxValues = 1;
+        ASSERT_EQUALS(1U, tokenValues(code, "x ;", settings).size());
+
+        // max steps per function
+        const char code2[] = "void f() {\n"
+                             "    int x = 1;\n"
+                             "    a = 1;\n"
+                             "    b = 2;\n"
+                             "    c = x;\n"
+                             "}";
+        settings.valueFlowMaxValues = 0;
+        ASSERT_EQUALS(1U, tokenValues(code2, "x ; }", settings).size());
+        settings.valueFlowMaxSteps = 4;
+        ASSERT_EQUALS(0U, tokenValues(code2, "x ; }", settings).size());
+    }
+
+    void valueFlowCostReport() {
+        const char code[] = "void f() {\n"
+                            "    int x = 1;\n"
+                            "    a = 1;\n"
+                            "    b = 2;\n"
+                            "    c = x;\n"
+                            "}\n"
+                            "void g(int y) {\n"
+                            "    if (y == 0) {}\n"
+                            "    d = y;\n"
+                            "}\n"
+                            "int z;\n"
+                            "void h() {\n"
+                            "    if (z == 0) {}\n"
+                            "}";
+        Settings settings;
+        settings.valueFlowMaxSteps = 4;
+        ValueFlow::Costs costs;
+        Tokenizer tokenizer(&settings, this);
+        tokenizer.setValueFlowCosts(&costs);
+        std::istringstream istr(code);
+        tokenizer.tokenize(istr, "test.cpp");
+        tokenizer.simplifyTokenList2();
+
+        // one line per function and one per bailout reason, the costs of
+        // both value flow runs are added
+        const std::list<std::string> report(ValueFlow::costReport(costs));
+        std::ostringstream ostr;
+        for (std::list<std::string>::const_iterator it = report.begin(); it != report.end(); ++it)
+            ostr << *it << '\n';
+        ASSERT_EQUALS("ValueFlow: g [test.cpp:7]: 6 steps, 2 values\n"
+                      "ValueFlow: f [test.cpp:1]: 4 steps, 6 values, bailouts: max steps\n"
+                      "ValueFlow: f [test.cpp:1]: bailout: variable x valueFlowForward, step budget exhausted\n"
+                      "ValueFlow: h [test.cpp:12]: 0 steps, 0 values\n"
+                      "ValueFlow: h [test.cpp:12]: bailout: global variable z\n", ostr.str());
     }
 };
 
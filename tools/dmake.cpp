@@ -299,6 +299,8 @@ int main(int argc, char **argv)
          << "        endif # !CPPCHK_GLIBCXX_DEBUG\n"
          << "    endif # GNU/kFreeBSD\n"
          << "\n"
+         << "    # --check-threads uses std::thread\n"
+         << "    LDFLAGS += -pthread\n"
          << "endif # COMSPEC\n"
          << "\n";
 